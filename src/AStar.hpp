@@ -4,221 +4,107 @@
 #include "Config.hpp"
 
 #include "Notifier.hpp"
+#include "OccupancyGrid.hpp"
+#include "OpenSet.hpp"
 #include "Point.hpp"
+#include "SearchGrid.hpp"
+#include "SearchStats.hpp"
+#include "Vertex.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
-#include <map>
 #include <mutex>
-#include <set>
 #include <vector>
 
 
 namespace PathAlgorithm
 {
+	/*
+	 *
+	 */
+	typedef std::vector< Vertex > Path;
+	typedef ClosedSetView ClosedSet;
+	typedef PredecessorMapView VertexMap;
 	/**
-	 * A Vertex is the dot in a graph.
+	 *
 	 */
-	struct Vertex
+	class AStar : public Base::Notifier
 	{
+		public:
 			/**
-			 *
-			 */
-			Vertex( int anX,
-					int anY) :
-						x( anX),
-						y( anY),
-						actualCost( 0.0),
-						heuristicCost( 0.0)
-			{
-			}
-			/**
-			 *
+			 * The result of a step of a resumable search
 			 */
-			explicit Vertex( const wxPoint& aPoint) :
-				x( aPoint.x),
-				y( aPoint.y),
-				actualCost( 0.0),
-				heuristicCost( 0.0)
+			enum SearchStatus
 			{
-			}
+				SearchFound,
+				SearchSuspended,
+				SearchFailed
+			};
 			/**
 			 *
 			 */
-			 Vertex( const Vertex&) = default;
+			AStar();
 			/**
 			 *
 			 */
-			 Vertex( Vertex&&) = default;
+			virtual ~AStar() = default;
 			/**
 			 *
 			 */
-			 Vertex& operator=( const Vertex&) = default;
+			Path search(const wxPoint& aStartPoint,
+						const wxPoint& aGoalPoint,
+						const wxSize& aRobotSize);
 			/**
+			 * Writes the path into aPath, reusing its storage. aPath is empty if there is no route.
 			 *
+			 * @return what the search cost
 			 */
-			wxPoint asPoint() const
-			{
-				return wxPoint( x, y);
-			}
+			SearchStats search(	const wxPoint& aStartPoint,
+								const wxPoint& aGoalPoint,
+								const wxSize& aRobotSize,
+								Path& aPath);
 			/**
 			 *
 			 */
-			bool lessCost( const Vertex& aVertex) const
-			{
-				if (heuristicCost < aVertex.heuristicCost)
-					return true;
-				// less uncertainty if the actual cost is smaller
-				if (heuristicCost == aVertex.heuristicCost)
-					return actualCost > aVertex.actualCost;
-				return false;
-			}
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const wxSize& aRobotSize);
 			/**
-			 *
+			 * Writes the path into aPath, reusing its storage. aPath is empty if there is no route.
+			 * All other search functions end up here.
 			 */
-			bool lessId( const Vertex& aVertex) const
-			{
-				if ( x < aVertex.x) return true;
-				if ( x == aVertex.x) return y < aVertex.y;
-				return false;
-			}
+			virtual void search(Vertex aStart,
+								const Vertex& aGoal,
+								const wxSize& aRobotSize,
+								Path& aPath);
 			/**
-			 *
+			 * Starts a search that is resumed in steps with a budget, the planner keeps its state in between.
+			 * Nothing is expanded yet. The search is always that of AStar, with the successors of the derived
+			 * class, and it uses the walls as they are now.
 			 */
-			bool equalPoint( const Vertex& aVertex) const
-			{
-				return x == aVertex.x && y == aVertex.y;
-			}
-
-			int x;
-			int y;
-
-			double actualCost;
-			double heuristicCost;
-	};
-	// struct Vertex
-
-	/**
-	 *
-	 */
-	struct VertexLessCostCompare
-	{
-			bool operator()(	const Vertex& lhs,
-								const Vertex& rhs) const
-			{
-				return lhs.lessCost( rhs);
-			}
-	};
-	// struct VertexCostCompare
-	/**
-	 *
-	 */
-	struct VertexLessIdCompare
-	{
-			bool operator()(	const Vertex& lhs,
-								const Vertex& rhs) const
-			{
-				return lhs.lessId( rhs);
-			}
-	};
-	// struct VertexIdCompare
-	/**
-	 *
-	 */
-	struct VertexEqualPointCompare
-	{
-			bool operator()(	const Vertex& lhs,
-								const Vertex& rhs) const
-			{
-				return lhs.equalPoint( rhs);
-			}
-	};
-	// struct VertexPointCompare
-
-	/**
-	 * An edge is a line between dots…
-	 */
-	struct Edge
-	{
-			Edge(	const Vertex& aVertex1,
-					const Vertex& aVertex2) :
-						vertex1( aVertex1),
-						vertex2( aVertex2)
-			{
-			}
-			Edge( const Edge& anEdge) :
-				vertex1( anEdge.vertex1),
-				vertex2( anEdge.vertex2)
-			{
-			}
-
-			const Vertex& thisSide( const Vertex& aVertex) const
-			{
-				if (vertex1.equalPoint( aVertex))
-					return vertex1;
-				if (vertex2.equalPoint( aVertex))
-					return vertex2;
-				throw std::logic_error( "thisSide: huh???");
-			}
-
-			const Vertex& otherSide( const Vertex& aVertex) const
-			{
-				if (vertex1.equalPoint( aVertex))
-					return vertex2;
-				if (vertex2.equalPoint( aVertex))
-					return vertex1;
-				throw std::logic_error( "otherSide: huh???");
-			}
-
-			Vertex vertex1;
-			Vertex vertex2;
-	}; // struct Edge
-	/**
-	 *
-	 * @param os
-	 * @param aVertex
-	 * @return
-	 */
-	inline std::ostream& operator<<( 	std::ostream& os,
-										const Vertex & aVertex)
-	{
-		return os << "(" << aVertex.x << "," << aVertex.y << "), " << aVertex.actualCost << " " << aVertex.heuristicCost;
-	}
-	/**
-	 *
-	 * @param os
-	 * @param anEdge
-	 * @return
-	 */
-	inline std::ostream& operator<<( 	std::ostream& os,
-										const Edge& anEdge)
-	{
-		return os << anEdge.vertex1 << " -> " << anEdge.vertex2;
-	}
-	/*
-	 *
-	 */
-	typedef std::vector< Vertex > Path;
-	typedef std::vector< Vertex > OpenSet;
-	typedef std::set< Vertex, VertexLessIdCompare > ClosedSet;
-	typedef std::map< Vertex, Vertex, VertexLessIdCompare > VertexMap;
-	/**
-	 *
-	 */
-	class AStar : public Base::Notifier
-	{
-		public:
+			void startSearch(	const wxPoint& aStartPoint,
+								const wxPoint& aGoalPoint,
+								const wxSize& aRobotSize);
 			/**
+			 * Continues the search of startSearch() for at most aMaxExpansions Vertices (0 is no limit) and
+			 * not beyond aDeadline. If the goal is found the path is written into aPath. If the budget runs out
+			 * first the best partial path is written: the one from the start to the expanded Vertex closest to
+			 * the goal. A next call continues where this one stopped.
 			 *
+			 * @return SearchSuspended until the goal is found or there is no route
 			 */
-			Path search(const wxPoint& aStartPoint,
-						const wxPoint& aGoalPoint,
-						const wxSize& aRobotSize);
+			SearchStatus resumeSearch(	std::size_t aMaxExpansions,
+										std::chrono::steady_clock::time_point aDeadline,
+										Path& aPath);
 			/**
 			 *
 			 */
-			Path search(Vertex aStart,
-						const Vertex& aGoal,
-						const wxSize& aRobotSize);
+			SearchStatus getSearchStatus() const
+			{
+				return searchStatus;
+			}
 			/**
 			 *
 			 */
@@ -254,37 +140,121 @@ namespace PathAlgorithm
 			/**
 			 *
 			 */
-			void removeFromClosedSet( ClosedSet::iterator& i);
-			/**
-			 *
-			 */
-			ClosedSet::iterator findInClosedSet( const Vertex& aVertex);
+			bool findInClosedSet( const Vertex& aVertex) const;
 			/**
 			 *
 			 */
 			bool findRemoveClosedSet( const Vertex& aVertex);
 			/**
-			 *
+			 * The returned view is only valid until the next search
 			 */
 			ClosedSet getClosedSet() const;
 			/**
-			 *
+			 * Returns a copy of the openSet as it was at the latest notification
 			 */
 			OpenSet getOpenSet() const;
 			/**
-			 *
+			 * The returned view is only valid until the next search
 			 */
 			VertexMap getPredecessorMap() const;
+			/**
+			 * Reduces aPath, a path of the latest search, to its corners: every Vertex that can be seen in a
+			 * straight line from the previous corner is dropped (string pulling). The actual costs become the
+			 * lengths of the straight lines so far. The path is as long as the original or shorter, and every
+			 * cell that a new straight line touches is free.
+			 */
+			void smoothPath( Path& aPath) const;
+			/**
+			 * Same as above, for any path: anIsLineFree tells whether a robot fits on a straight line
+			 */
+			static void smoothPath(	Path& aPath,
+									const std::function< bool( const Vertex&, const Vertex&) >& anIsLineFree);
+			/**
+			 * A search does not notify its observers on every change: it notifies once every anExpansions
+			 * expanded Vertices or once every anInterval, whichever comes first, and once when it is done.
+			 */
+			void setNotificationCadence(	unsigned long anExpansions,
+											std::chrono::milliseconds anInterval);
+			/**
+			 *
+			 * @return the radius of the circle around a robot of aRobotSize, the walls are inflated with it
+			 */
+			static int getFreeRadius( const wxSize& aRobotSize);
+			/**
+			 *
+			 * @return the number of Vertices that the latest search expanded
+			 */
+			std::size_t getExpandedCount() const
+			{
+				return searchStats.expandedCount;
+			}
+			/**
+			 * The statistics of the latest search, or of the resumed search so far
+			 */
+			const SearchStats& getSearchStats() const
+			{
+				return searchStats;
+			}
 
 		protected:
 			/**
+			 * Brings the OccupancyGrid up to date for a robot of aRobotSize
 			 *
+			 * @return the free radius of the robot
 			 */
-			ClosedSet& getCS();
+			int synchroniseOccupancyGrid( const wxSize& aRobotSize);
 			/**
-			 *
+			 * Sizes aGrid to the bounding box of the start, the goal and all walls plus aMargin and clears it
 			 */
-			const ClosedSet& getCS() const;
+			static void resetGrid(	SearchGrid& aGrid,
+									const Vertex& aStart,
+									const Vertex& aGoal,
+									int aMargin);
+			/**
+			 * Collects the statistics of a search, every search starts with resetSearchStats()
+			 */
+			void resetSearchStats()
+			{
+				searchStats.clear();
+			}
+			void countExpansion()
+			{
+				++searchStats.expandedCount;
+			}
+			void countReopening()
+			{
+				++searchStats.reopenedCount;
+			}
+			void countWallCheck() const
+			{
+				++searchStats.wallCheckCount;
+			}
+			void countOpenSetSize( std::size_t aSize)
+			{
+				searchStats.openSetPeak = std::max( searchStats.openSetPeak, aSize);
+			}
+			void countAllocations( std::size_t aCount)
+			{
+				searchStats.allocationCount += aCount;
+			}
+			/**
+			 * Appends the Vertices that can be reached from aCurrent to aSuccessors. The default are the
+			 * free neighbours of aCurrent. A successor that is not a neighbour must be on a straight or
+			 * diagonal line from aCurrent.
+			 */
+			virtual void getSuccessors(	const Vertex& aCurrent,
+										std::int32_t aCurrentCell,
+										const Vertex& aGoal,
+										std::vector< Vertex >& aSuccessors) const;
+			/**
+			 * @return true if a robot of the latest search can drive in a straight line from aFrom to aTo
+			 */
+			virtual bool isLineFree(	const Vertex& aFrom,
+										const Vertex& aTo) const;
+			/**
+			 * Called after every expansion, notifies the observers if the cadence says so or if aFinal is true
+			 */
+			void notifyProgress( bool aFinal = false);
 			/**
 			 *
 			 */
@@ -296,25 +266,74 @@ namespace PathAlgorithm
 			/**
 			 *
 			 */
-			VertexMap& getPM();
+			SearchGrid& getGrid();
 			/**
 			 *
 			 */
-			const VertexMap& getPM() const;
+			const SearchGrid& getGrid() const;
+			/**
+			 *
+			 */
+			const OccupancyGrid& getOccupancyGrid() const;
 
 		private:
 			/**
-			 *
+			 * Runs the search of the planner and measures it
+			 */
+			void timedSearch(	const Vertex& aStart,
+								const Vertex& aGoal,
+								const wxSize& aRobotSize,
+								Path& aPath);
+			/**
+			 * Puts aStart in the cleared openSet and grid
+			 */
+			void initialiseSearch(	Vertex aStart,
+									const Vertex& aGoal);
+			/**
+			 * Expands Vertices until the goal is found, the openSet is empty or the budget runs out
 			 */
-			ClosedSet closedSet;
+			SearchStatus expandUntil(	std::size_t aMaxExpansions,
+										std::chrono::steady_clock::time_point aDeadline,
+										Path& aPath);
 			/**
 			 *
 			 */
 			OpenSet openSet;
 			/**
-			 *
+			 * The closed set, predecessors and actual costs of all cells, reused between searches
+			 */
+			SearchGrid grid;
+			/**
+			 * The walls inflated with the radius of the robot, kept up to date between searches
+			 */
+			OccupancyGrid occupancyGrid;
+			/**
+			 * The successors of the current Vertex, kept to reuse its storage
+			 */
+			std::vector< Vertex > successors;
+			/**
+			 * The wall checks are counted by the successor functions, which are const
+			 */
+			mutable SearchStats searchStats;
+			/**
+			 * The state of the latest search that is not kept in the openSet and the grid
+			 */
+			Vertex searchGoal;
+			SearchStatus searchStatus;
+			std::int32_t closestCell;
+			double closestDistance;
+			/**
+			 * The notification cadence
+			 */
+			unsigned long notificationExpansions;
+			std::chrono::milliseconds notificationInterval;
+			unsigned long expansionsSinceNotification;
+			std::chrono::steady_clock::time_point lastNotification;
+			/**
+			 * The openSet as published to the observers
 			 */
-			VertexMap predecessorMap;
+			OpenSet openSetSnapshot;
+			mutable std::mutex snapshotMutex;
 	}; // class AStar
 } // namespace PathAlgorithm
 #endif // ASTAR_HPP_
@@ -0,0 +1,196 @@
+#include "BidirectionalAStar.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 * Same as the cost and the heuristic of AStar
+		 */
+		double Distance(	const Vertex& aStart,
+							const Vertex& aGoal)
+		{
+			return std::sqrt( (aStart.x - aGoal.x) * (aStart.x - aGoal.x) + (aStart.y - aGoal.y) * (aStart.y - aGoal.y));
+		}
+		/**
+		 * The average heuristic of a search from aSource to aTarget, the one of the opposite search is its negation
+		 */
+		double Potential(	const Vertex& aVertex,
+							const Vertex& aSource,
+							const Vertex& aTarget)
+		{
+			return (Distance( aVertex, aTarget) - Distance( aVertex, aSource)) / 2.0;
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	BidirectionalAStar::BidirectionalAStar() :
+		bestCost( std::numeric_limits< double >::infinity()),
+		meetingCell( SearchGrid::NoCell)
+	{
+	}
+	/**
+	 *
+	 */
+	void BidirectionalAStar::search(	Vertex aStart,
+										const Vertex& aGoal,
+										const wxSize& aRobotSize,
+										Path& aPath)
+	{
+		aPath.clear();
+		getOS().clear();
+		backwardOpenSet.clear();
+		resetSearchStats();
+
+		int radius = synchroniseOccupancyGrid( aRobotSize);
+
+		SearchGrid& forwardGrid = getGrid();
+		resetGrid( forwardGrid, aStart, aGoal, radius + 1);
+		backwardGrid.reset( forwardGrid.getLeft(), forwardGrid.getTop(), forwardGrid.getWidth(), forwardGrid.getHeight());
+
+		bestCost = std::numeric_limits< double >::infinity();
+		meetingCell = SearchGrid::NoCell;
+
+		aStart.actualCost = 0.0;
+		aStart.heuristicCost = Potential( aStart, aStart, aGoal);
+		forwardGrid.setCost( forwardGrid.cellIndex( aStart), 0.0);
+		getOS().push( aStart);
+
+		Vertex goal = aGoal;
+		goal.actualCost = 0.0;
+		goal.heuristicCost = Potential( aGoal, aGoal, aStart);
+		backwardGrid.setCost( backwardGrid.cellIndex( goal), 0.0);
+		backwardOpenSet.push( goal);
+
+		if (aStart.equalPoint( aGoal))
+		{
+			bestCost = 0.0;
+			meetingCell = forwardGrid.cellIndex( aStart);
+		}
+
+		while (!getOS().empty() && !backwardOpenSet.empty())
+		{
+			// Every path that is not found yet goes through a Vertex in each openSet and the estimates of both
+			// searches add up to the cost of a path, so it can not be shorter than the sum of the least estimates
+			if (getOS().front().heuristicCost + backwardOpenSet.front().heuristicCost >= bestCost)
+			{
+				break;
+			}
+
+			if (getOS().size() <= backwardOpenSet.size())
+			{
+				expand( getOS(), forwardGrid, backwardGrid, aStart, aGoal);
+			} else
+			{
+				expand( backwardOpenSet, backwardGrid, forwardGrid, aGoal, aStart);
+			}
+			countExpansion();
+			notifyProgress();
+		}
+
+		if (meetingCell == SearchGrid::NoCell)
+		{
+			notifyProgress( true);
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+			return;
+		}
+
+		constructPath( aPath);
+		notifyProgress( true);
+	}
+	/**
+	 *
+	 */
+	void BidirectionalAStar::expand(	OpenSet& anOpenSet,
+										SearchGrid& aGrid,
+										const SearchGrid& anOtherGrid,
+										const Vertex& aSource,
+										const Vertex& aTarget)
+	{
+		Vertex current = anOpenSet.front();
+		anOpenSet.pop();
+		std::int32_t currentCell = aGrid.cellIndex( current);
+		aGrid.setClosed( currentCell);
+
+		// The moves are symmetric, so the neighbours of AStar are the successors of both searches
+		successors.clear();
+		AStar::getSuccessors( current, currentCell, aTarget, successors);
+
+		for (Vertex neighbour : successors)
+		{
+			std::int32_t neighbourCell = aGrid.cellIndex( neighbour);
+			if (neighbourCell == SearchGrid::NoCell)
+			{
+				continue;
+			}
+
+			neighbour.actualCost = current.actualCost + Distance( current, neighbour);
+			if (aGrid.getCost( neighbourCell) <= neighbour.actualCost)
+			{
+				continue;
+			}
+			neighbour.heuristicCost = neighbour.actualCost + Potential( neighbour, aSource, aTarget);
+
+			if (aGrid.isClosed( neighbourCell))
+			{
+				aGrid.setClosed( neighbourCell, false);
+				countReopening();
+			}
+			std::size_t allocations = anOpenSet.getAllocationCount();
+			anOpenSet.push( neighbour);
+			countAllocations( anOpenSet.getAllocationCount() - allocations);
+			countOpenSetSize( getOS().size() + backwardOpenSet.size());
+			aGrid.setCost( neighbourCell, neighbour.actualCost);
+			aGrid.setPredecessor( neighbourCell, currentCell);
+
+			// Reached by the other search as well?
+			double viaNeighbour = neighbour.actualCost + anOtherGrid.getCost( neighbourCell);
+			if (viaNeighbour < bestCost)
+			{
+				bestCost = viaNeighbour;
+				meetingCell = neighbourCell;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void BidirectionalAStar::constructPath( Path& aPath) const
+	{
+		const SearchGrid& forwardGrid = getGrid();
+
+		// Count first so the path is filled without any reallocation or copying
+		std::size_t forwardLength = 0;
+		for (std::int32_t cell = meetingCell; cell != SearchGrid::NoCell; cell = forwardGrid.getPredecessor( cell))
+		{
+			++forwardLength;
+		}
+		std::size_t backwardLength = 0;
+		for (std::int32_t cell = backwardGrid.getPredecessor( meetingCell); cell != SearchGrid::NoCell; cell = backwardGrid.getPredecessor( cell))
+		{
+			++backwardLength;
+		}
+
+		aPath.assign( forwardLength + backwardLength, Vertex( 0, 0));
+
+		// From the meeting cell back to the start...
+		std::size_t i = forwardLength;
+		for (std::int32_t cell = meetingCell; cell != SearchGrid::NoCell; cell = forwardGrid.getPredecessor( cell))
+		{
+			aPath[--i] = forwardGrid.cellVertex( cell);
+		}
+		// ...and on to the goal, the actual cost is what is left of the cost of the path
+		i = forwardLength;
+		for (std::int32_t cell = backwardGrid.getPredecessor( meetingCell); cell != SearchGrid::NoCell; cell = backwardGrid.getPredecessor( cell))
+		{
+			aPath[i] = backwardGrid.cellVertex( cell);
+			aPath[i].actualCost = bestCost - backwardGrid.getCost( cell);
+			++i;
+		}
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,71 @@
+#ifndef BIDIRECTIONALASTAR_HPP_
+#define BIDIRECTIONALASTAR_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * BidirectionalAStar grows a search from the start and one from the goal, always the one with the
+	 * smallest openSet. Every time a Vertex is reached that the other search reached too, a path is found.
+	 *
+	 * Both searches order their openSets on the average of the two heuristics (Ikeda et al., 1994): half
+	 * the distance to their target minus half the distance to their source. The estimates of both searches
+	 * of a Vertex then add up to the cost of the path through it, so the search stops as soon as the least
+	 * estimates of both openSets add up to the cost of the best path found, which is as short as the one of
+	 * AStar. In long corridors the two searches expand fewer Vertices than a single one.
+	 *
+	 * The openSet, the closed set and the predecessors of AStar are those of the search from the start.
+	 */
+	class BidirectionalAStar : public AStar
+	{
+		public:
+			/**
+			 *
+			 */
+			BidirectionalAStar();
+			/**
+			 *
+			 */
+			using AStar::search;
+			/**
+			 *
+			 */
+			virtual void search(Vertex aStart,
+								const Vertex& aGoal,
+								const wxSize& aRobotSize,
+								Path& aPath) override;
+
+		private:
+			/**
+			 * Expands the first Vertex of anOpenSet and records the best meeting point with the other search
+			 */
+			void expand(	OpenSet& anOpenSet,
+							SearchGrid& aGrid,
+							const SearchGrid& anOtherGrid,
+							const Vertex& aSource,
+							const Vertex& aTarget);
+			/**
+			 * Writes the path through the meeting cell into aPath
+			 */
+			void constructPath( Path& aPath) const;
+
+			/**
+			 * The search from the goal
+			 */
+			OpenSet backwardOpenSet;
+			SearchGrid backwardGrid;
+			/**
+			 * The cost of the shortest path found so far and the cell where both searches met
+			 */
+			double bestCost;
+			std::int32_t meetingCell;
+			/**
+			 * The successors of the current Vertex, kept to reuse its storage
+			 */
+			std::vector< Vertex > successors;
+	}; // class BidirectionalAStar
+} // namespace PathAlgorithm
+#endif // BIDIRECTIONALASTAR_HPP_
@@ -0,0 +1,194 @@
+#include "ClearanceMap.hpp"
+
+#include "RobotWorld.hpp"
+#include "Wall.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		const float Infinity = std::numeric_limits< float >::infinity();
+	} // namespace
+	/**
+	 *
+	 */
+	/* static */ ClearanceMapPtr ClearanceMap::getClearanceMap()
+	{
+		static std::mutex clearanceMapMutex;
+		static ClearanceMapPtr clearanceMap;
+
+		std::lock_guard< std::mutex > lock( clearanceMapMutex);
+		const Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		if (!clearanceMap || clearanceMap->getGeometryVersion() != robotWorld.getGeometryVersion())
+		{
+			clearanceMap = std::make_shared< const ClearanceMap >( robotWorld.getWalls(), robotWorld.getGeometryVersion());
+		}
+		return clearanceMap;
+	}
+	/**
+	 *
+	 */
+	ClearanceMap::ClearanceMap(	const std::vector< Model::WallPtr >& aWalls,
+								unsigned long aGeometryVersion,
+								int aMargin /*= 64*/) :
+		geometryVersion( aGeometryVersion),
+		left( 0),
+		top( 0),
+		width( 0),
+		height( 0),
+		wallsLeft( 0),
+		wallsTop( 0),
+		wallsRight( 0),
+		wallsBottom( 0),
+		hasWalls( !aWalls.empty())
+	{
+		if (!hasWalls)
+		{
+			return;
+		}
+
+		wallsLeft = wallsTop = std::numeric_limits< int >::max();
+		wallsRight = wallsBottom = std::numeric_limits< int >::min();
+		for (const Model::WallPtr& wall : aWalls)
+		{
+			wallsLeft = std::min( { wallsLeft, wall->getPoint1().x, wall->getPoint2().x });
+			wallsTop = std::min( { wallsTop, wall->getPoint1().y, wall->getPoint2().y });
+			wallsRight = std::max( { wallsRight, wall->getPoint1().x, wall->getPoint2().x });
+			wallsBottom = std::max( { wallsBottom, wall->getPoint1().y, wall->getPoint2().y });
+		}
+
+		left = wallsLeft - aMargin;
+		top = wallsTop - aMargin;
+		width = wallsRight - wallsLeft + 2 * aMargin + 1;
+		height = wallsBottom - wallsTop + 2 * aMargin + 1;
+
+		distances.assign( static_cast< std::size_t >( width) * static_cast< std::size_t >( height), Infinity);
+		for (const Model::WallPtr& wall : aWalls)
+		{
+			rasterize( wall->getPoint1(), wall->getPoint2(), distances);
+		}
+
+		// The transform is separable: first down the columns, then along the rows
+		int longest = std::max( width, height);
+		values.resize( static_cast< std::size_t >( longest));
+		parabolas.resize( static_cast< std::size_t >( longest));
+		boundaries.resize( static_cast< std::size_t >( longest) + 1);
+		for (int column = 0; column < width; ++column)
+		{
+			transform( distances.data() + column, height, width);
+		}
+		for (int row = 0; row < height; ++row)
+		{
+			transform( distances.data() + static_cast< std::size_t >( row) * static_cast< std::size_t >( width), width, 1);
+		}
+
+		for (float& distance : distances)
+		{
+			distance = std::sqrt( distance);
+		}
+
+		// Only needed while building
+		std::vector< float >().swap( values);
+		std::vector< int >().swap( parabolas);
+		std::vector< float >().swap( boundaries);
+	}
+	/**
+	 *
+	 */
+	double ClearanceMap::getClearance(	int anX,
+										int anY) const
+	{
+		if (!hasWalls)
+		{
+			return std::numeric_limits< double >::infinity();
+		}
+
+		int column = anX - left;
+		int row = anY - top;
+		if (column < 0 || column >= width || row < 0 || row >= height)
+		{
+			int dx = std::max( { wallsLeft - anX, 0, anX - wallsRight });
+			int dy = std::max( { wallsTop - anY, 0, anY - wallsBottom });
+			return std::sqrt( static_cast< double >( dx) * dx + static_cast< double >( dy) * dy);
+		}
+		return distances[static_cast< std::size_t >( row) * static_cast< std::size_t >( width) + static_cast< std::size_t >( column)];
+	}
+	/**
+	 *
+	 */
+	void ClearanceMap::rasterize(	const wxPoint& aPoint1,
+									const wxPoint& aPoint2,
+									std::vector< float >& aSquaredDistances) const
+	{
+		int dx = aPoint2.x - aPoint1.x;
+		int dy = aPoint2.y - aPoint1.y;
+		int steps = std::max( std::abs( dx), std::abs( dy));
+		for (int i = 0; i <= steps; ++i)
+		{
+			double t = steps > 0 ? static_cast< double >( i) / steps : 0.0;
+			int column = static_cast< int >( std::lround( aPoint1.x + t * dx)) - left;
+			int row = static_cast< int >( std::lround( aPoint1.y + t * dy)) - top;
+			aSquaredDistances[static_cast< std::size_t >( row) * static_cast< std::size_t >( width) + static_cast< std::size_t >( column)] = 0.0f;
+		}
+	}
+	/**
+	 *
+	 */
+	void ClearanceMap::transform(	float* aFirst,
+									int aCount,
+									int aStride)
+	{
+		for (int i = 0; i < aCount; ++i)
+		{
+			values[static_cast< std::size_t >( i)] = aFirst[static_cast< std::ptrdiff_t >( i) * aStride];
+		}
+
+		// The lower envelope of the parabolas rooted at the cells that have a finite value
+		int count = -1;
+		for (int q = 0; q < aCount; ++q)
+		{
+			float value = values[static_cast< std::size_t >( q)];
+			if (value == Infinity)
+			{
+				continue;
+			}
+			float boundary = -Infinity;
+			while (count >= 0)
+			{
+				int p = parabolas[static_cast< std::size_t >( count)];
+				boundary = ((value + static_cast< float >( q * q)) - (values[static_cast< std::size_t >( p)] + static_cast< float >( p * p))) / static_cast< float >( 2 * (q - p));
+				if (boundary > boundaries[static_cast< std::size_t >( count)])
+				{
+					break;
+				}
+				--count;
+			}
+			++count;
+			parabolas[static_cast< std::size_t >( count)] = q;
+			boundaries[static_cast< std::size_t >( count)] = count == 0 ? -Infinity : boundary;
+		}
+
+		// Nothing to measure against in this line
+		if (count < 0)
+		{
+			return;
+		}
+
+		int k = 0;
+		for (int q = 0; q < aCount; ++q)
+		{
+			while (k < count && boundaries[static_cast< std::size_t >( k) + 1] < static_cast< float >( q))
+			{
+				++k;
+			}
+			int p = parabolas[static_cast< std::size_t >( k)];
+			aFirst[static_cast< std::ptrdiff_t >( q) * aStride] = static_cast< float >( (q - p) * (q - p)) + values[static_cast< std::size_t >( p)];
+		}
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,107 @@
+#ifndef CLEARANCEMAP_HPP_
+#define CLEARANCEMAP_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Model
+{
+	class Wall;
+	typedef std::shared_ptr< Wall > WallPtr;
+}
+
+namespace PathAlgorithm
+{
+	class ClearanceMap;
+	typedef std::shared_ptr< const ClearanceMap > ClearanceMapPtr;
+
+	/**
+	 * The ClearanceMap holds for every cell the Euclidean distance to the nearest cell of a wall (an exact
+	 * distance transform, Felzenszwalb and Huttenlocher, 2012). It does not depend on the size of a robot:
+	 * whether a robot with any free radius fits at a cell is a single lookup. Because the walls are
+	 * rasterized the distance to the wall itself may be up to half a diagonal of a cell smaller.
+	 *
+	 * Outside the map the distance to the bounding box of the walls is returned, which is never more than
+	 * the distance to the nearest wall.
+	 */
+	class ClearanceMap
+	{
+		public:
+			/**
+			 * @return the map of the walls of the RobotWorld as they are now, built only once per geometry version
+			 */
+			static ClearanceMapPtr getClearanceMap();
+			/**
+			 * Builds the map over the bounding box of the walls plus aMargin on every side
+			 */
+			ClearanceMap(	const std::vector< Model::WallPtr >& aWalls,
+							unsigned long aGeometryVersion,
+							int aMargin = 64);
+			/**
+			 *
+			 * @return the distance from (anX,anY) to the nearest cell of a wall
+			 */
+			double getClearance(	int anX,
+									int anY) const;
+			/**
+			 *
+			 * @return true if no cell of a wall is within aRadius of (anX,anY)
+			 */
+			bool isFree(	int anX,
+							int anY,
+							double aRadius) const
+			{
+				return getClearance( anX, anY) > aRadius;
+			}
+			/**
+			 *
+			 */
+			unsigned long getGeometryVersion() const
+			{
+				return geometryVersion;
+			}
+
+		private:
+			/**
+			 * Sets the cells of the segment from aPoint1 to aPoint2 to distance 0
+			 */
+			void rasterize(	const wxPoint& aPoint1,
+							const wxPoint& aPoint2,
+							std::vector< float >& aSquaredDistances) const;
+			/**
+			 * The squared distance transform in one dimension of aCount values from aFirst on, aStride apart
+			 */
+			void transform(	float* aFirst,
+							int aCount,
+							int aStride);
+
+			unsigned long geometryVersion;
+			/**
+			 * The bounds of the map and of the walls
+			 */
+			int left;
+			int top;
+			int width;
+			int height;
+			int wallsLeft;
+			int wallsTop;
+			int wallsRight;
+			int wallsBottom;
+			bool hasWalls;
+			/**
+			 *
+			 */
+			std::vector< float > distances;
+			/**
+			 * Reused storage for the one dimensional transforms
+			 */
+			std::vector< float > values;
+			std::vector< int > parabolas;
+			std::vector< float > boundaries;
+	}; // class ClearanceMap
+} // namespace PathAlgorithm
+#endif // CLEARANCEMAP_HPP_
@@ -0,0 +1,577 @@
+#include "ClusterGraph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 * Entrances that are wider than this get a transition at both ends instead of one in the middle
+		 */
+		const int MaxEntranceWidth = 6;
+		/**
+		 *
+		 */
+		const double Infinity = std::numeric_limits< double >::infinity();
+		/**
+		 * The order of the nodes in a cluster
+		 */
+		bool lessCell(	const wxPoint& lhs,
+						const wxPoint& rhs)
+		{
+			return lhs.y < rhs.y || (lhs.y == rhs.y && lhs.x < rhs.x);
+		}
+		/**
+		 * Same as the distance that AStar uses
+		 */
+		double Distance(	const wxPoint& aStart,
+							const wxPoint& aGoal)
+		{
+			return std::sqrt( (aStart.x - aGoal.x) * (aStart.x - aGoal.x) + (aStart.y - aGoal.y) * (aStart.y - aGoal.y));
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	ClusterGraph::ClusterGraph( int aClusterSize /*= 32*/) :
+		clusterSize( aClusterSize),
+		occupancyGrid( nullptr),
+		geometryVersion( 0),
+		rebuildCount( 0),
+		rebuiltClusterCount( 0),
+		left( 0),
+		top( 0),
+		width( 0),
+		height( 0),
+		clustersX( 0),
+		clustersY( 0),
+		localLeft( 0),
+		localTop( 0),
+		localWidth( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	void ClusterGraph::update( const OccupancyGrid& anOccupancyGrid)
+	{
+		bool rebuildAll = occupancyGrid == nullptr || anOccupancyGrid.getRebuildCount() != rebuildCount;
+		occupancyGrid = &anOccupancyGrid;
+
+		if (!rebuildAll && anOccupancyGrid.getGeometryVersion() == geometryVersion)
+		{
+			return;
+		}
+
+		// If the grid was synchronised more than once since the latest update the changed areas of the
+		// synchronisations in between are lost, all clusters may have changed
+		if (rebuildAll || anOccupancyGrid.getChangedSinceVersion() != geometryVersion)
+		{
+			rebuildCount = anOccupancyGrid.getRebuildCount();
+			geometryVersion = anOccupancyGrid.getGeometryVersion();
+
+			left = anOccupancyGrid.getLeft();
+			top = anOccupancyGrid.getTop();
+			width = anOccupancyGrid.getWidth();
+			height = anOccupancyGrid.getHeight();
+			clustersX = (width + clusterSize - 1) / clusterSize;
+			clustersY = (height + clusterSize - 1) / clusterSize;
+
+			std::size_t clusterCount = static_cast< std::size_t >( clustersX) * static_cast< std::size_t >( clustersY);
+			clusters.assign( clusterCount, Cluster());
+			eastTransitions.assign( clusterCount, std::vector< wxPoint >());
+			southTransitions.assign( clusterCount, std::vector< wxPoint >());
+
+			rebuild( std::vector< char >( clusterCount, 1));
+			return;
+		}
+		geometryVersion = anOccupancyGrid.getGeometryVersion();
+
+		// Only the clusters that overlap a changed area
+		std::vector< char > dirty( clusters.size(), 0);
+		for (const OccupancyGrid::Area& area : anOccupancyGrid.getChangedAreas())
+		{
+			int firstX = std::max( (area.left - left) / clusterSize, 0);
+			int lastX = std::min( (area.right - left) / clusterSize, clustersX - 1);
+			int firstY = std::max( (area.top - top) / clusterSize, 0);
+			int lastY = std::min( (area.bottom - top) / clusterSize, clustersY - 1);
+			for (int y = firstY; y <= lastY; ++y)
+			{
+				for (int x = firstX; x <= lastX; ++x)
+				{
+					dirty[static_cast< std::size_t >( y * clustersX + x)] = 1;
+				}
+			}
+		}
+		rebuild( dirty);
+	}
+	/**
+	 *
+	 */
+	bool ClusterGraph::findPath(	const Vertex& aStart,
+									const Vertex& aGoal,
+									std::vector< Vertex >& aPath)
+	{
+		aPath.clear();
+
+		wxPoint start( aStart.x, aStart.y);
+		wxPoint goal( aGoal.x, aGoal.y);
+		int startCluster = getCluster( start.x, start.y);
+		int goalCluster = getCluster( goal.x, goal.y);
+		if (startCluster == NoCluster || goalCluster == NoCluster || isBlocked( start) || isBlocked( goal))
+		{
+			return false;
+		}
+
+		aPath.push_back( aStart);
+
+		// If both are in the same cluster the path inside the cluster is tried first
+		if (startCluster == goalCluster && refine( start, goal, aPath))
+		{
+			return true;
+		}
+
+		// The costs from the start to the nodes of its cluster and from the nodes of the goal cluster to the goal
+		const Cluster& first = clusters[static_cast< std::size_t >( startCluster)];
+		expand( start, nullptr);
+		startCosts.resize( first.nodes.size());
+		for (std::size_t i = 0; i < first.nodes.size(); ++i)
+		{
+			startCosts[i] = localCosts[static_cast< std::size_t >( (first.nodes[i].y - localTop) * localWidth + first.nodes[i].x - localLeft)];
+		}
+		const Cluster& last = clusters[static_cast< std::size_t >( goalCluster)];
+		expand( goal, nullptr);
+		goalCosts.resize( last.nodes.size());
+		for (std::size_t i = 0; i < last.nodes.size(); ++i)
+		{
+			goalCosts[i] = localCosts[static_cast< std::size_t >( (last.nodes[i].y - localTop) * localWidth + last.nodes[i].x - localLeft)];
+		}
+
+		// AStar on the abstract graph, the goal is an extra node after all other nodes
+		std::int32_t goalNode = static_cast< std::int32_t >( nodeClusters.size());
+		abstractCosts.assign( nodeClusters.size() + 1, Infinity);
+		abstractPredecessors.assign( nodeClusters.size() + 1, -1);
+		abstractClosed.assign( nodeClusters.size() + 1, 0);
+		abstractQueue.clear();
+
+		auto nodeCell = [this]( std::int32_t aNode)
+		{
+			std::int32_t cluster = nodeClusters[static_cast< std::size_t >( aNode)];
+			return clusters[static_cast< std::size_t >( cluster)].nodes[static_cast< std::size_t >( aNode - firstNodes[static_cast< std::size_t >( cluster)])];
+		};
+		auto relax = [&]( std::int32_t aNode, std::int32_t aPredecessor, double aCost)
+		{
+			if (aCost < abstractCosts[static_cast< std::size_t >( aNode)])
+			{
+				abstractCosts[static_cast< std::size_t >( aNode)] = aCost;
+				abstractPredecessors[static_cast< std::size_t >( aNode)] = aPredecessor;
+				double heuristic = aNode == goalNode ? 0.0 : Distance( nodeCell( aNode), goal);
+				abstractQueue.push_back( std::make_pair( aCost + heuristic, aNode));
+				std::push_heap( abstractQueue.begin(), abstractQueue.end(), std::greater< std::pair< double, std::int32_t > >());
+			}
+		};
+
+		for (std::size_t i = 0; i < first.nodes.size(); ++i)
+		{
+			relax( firstNodes[static_cast< std::size_t >( startCluster)] + static_cast< std::int32_t >( i), -1, startCosts[i]);
+		}
+
+		bool found = false;
+		while (!abstractQueue.empty())
+		{
+			std::int32_t node = abstractQueue.front().second;
+			std::pop_heap( abstractQueue.begin(), abstractQueue.end(), std::greater< std::pair< double, std::int32_t > >());
+			abstractQueue.pop_back();
+
+			if (node == goalNode)
+			{
+				found = true;
+				break;
+			}
+			if (abstractClosed[static_cast< std::size_t >( node)])
+			{
+				continue;
+			}
+			abstractClosed[static_cast< std::size_t >( node)] = 1;
+
+			double cost = abstractCosts[static_cast< std::size_t >( node)];
+			std::int32_t cluster = nodeClusters[static_cast< std::size_t >( node)];
+			std::int32_t firstNode = firstNodes[static_cast< std::size_t >( cluster)];
+			const Cluster& current = clusters[static_cast< std::size_t >( cluster)];
+			std::size_t index = static_cast< std::size_t >( node - firstNode);
+			std::size_t count = current.nodes.size();
+
+			if (cluster == goalCluster)
+			{
+				relax( goalNode, node, cost + goalCosts[index]);
+			}
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (i != index)
+				{
+					relax( firstNode + static_cast< std::int32_t >( i), node, cost + current.costs[index * count + i]);
+				}
+			}
+			for (std::int32_t i = firstLinks[static_cast< std::size_t >( node)]; i < firstLinks[static_cast< std::size_t >( node) + 1]; ++i)
+			{
+				relax( links[static_cast< std::size_t >( i)], node, cost + 1.0);
+			}
+		}
+
+		if (!found)
+		{
+			aPath.clear();
+			return false;
+		}
+
+		abstractPath.clear();
+		for (std::int32_t node = abstractPredecessors[static_cast< std::size_t >( goalNode)]; node != -1; node = abstractPredecessors[static_cast< std::size_t >( node)])
+		{
+			abstractPath.push_back( node);
+		}
+		std::reverse( abstractPath.begin(), abstractPath.end());
+
+		// Refine the abstract path: nodes in the same cluster are connected by a path inside that cluster,
+		// nodes in different clusters are the two neighbouring cells of a transition
+		wxPoint previous = start;
+		std::int32_t previousCluster = startCluster;
+		for (std::int32_t node : abstractPath)
+		{
+			wxPoint cell = nodeCell( node);
+			std::int32_t cluster = nodeClusters[static_cast< std::size_t >( node)];
+			if (cluster == previousCluster)
+			{
+				if (!refine( previous, cell, aPath))
+				{
+					aPath.clear();
+					return false;
+				}
+			} else
+			{
+				aPath.push_back( Vertex( cell.x, cell.y));
+			}
+			previous = cell;
+			previousCluster = cluster;
+		}
+		if (!refine( previous, goal, aPath))
+		{
+			aPath.clear();
+			return false;
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	int ClusterGraph::getCluster(	int anX,
+									int anY) const
+	{
+		int column = anX - left;
+		int row = anY - top;
+		if (clusters.empty() || column < 0 || column >= width || row < 0 || row >= height)
+		{
+			return NoCluster;
+		}
+		return (row / clusterSize) * clustersX + column / clusterSize;
+	}
+	/**
+	 *
+	 */
+	void ClusterGraph::findTransitions(	int aCluster,
+										bool aSouth)
+	{
+		std::vector< wxPoint >& transitions = aSouth ? southTransitions[static_cast< std::size_t >( aCluster)] : eastTransitions[static_cast< std::size_t >( aCluster)];
+		transitions.clear();
+
+		int clusterX = aCluster % clustersX;
+		int clusterY = aCluster / clustersX;
+		if ((aSouth && clusterY + 1 >= clustersY) || (!aSouth && clusterX + 1 >= clustersX))
+		{
+			return;
+		}
+
+		// The border runs along the last row or column of this cluster, the other side is one further
+		wxPoint along = aSouth ? wxPoint( 1, 0) : wxPoint( 0, 1);
+		wxPoint across = aSouth ? wxPoint( 0, 1) : wxPoint( 1, 0);
+		wxPoint first = aSouth ? wxPoint( left + clusterX * clusterSize, top + (clusterY + 1) * clusterSize - 1) :
+								 wxPoint( left + (clusterX + 1) * clusterSize - 1, top + clusterY * clusterSize);
+		int length = aSouth ? std::min( clusterSize, left + width - first.x) :
+							  std::min( clusterSize, top + height - first.y);
+
+		int entrance = -1;
+		for (int i = 0; i <= length; ++i)
+		{
+			wxPoint cell( first.x + i * along.x, first.y + i * along.y);
+			bool free = i < length && !isBlocked( cell) && !isBlocked( wxPoint( cell.x + across.x, cell.y + across.y));
+			if (free && entrance == -1)
+			{
+				entrance = i;
+			} else if (!free && entrance != -1)
+			{
+				int end = i - 1;
+				if (end - entrance + 1 > MaxEntranceWidth)
+				{
+					transitions.push_back( wxPoint( first.x + entrance * along.x, first.y + entrance * along.y));
+					transitions.push_back( wxPoint( first.x + end * along.x, first.y + end * along.y));
+				} else
+				{
+					int middle = (entrance + end) / 2;
+					transitions.push_back( wxPoint( first.x + middle * along.x, first.y + middle * along.y));
+				}
+				entrance = -1;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void ClusterGraph::buildCluster( int aCluster)
+	{
+		Cluster& cluster = clusters[static_cast< std::size_t >( aCluster)];
+		cluster.nodes.clear();
+
+		int clusterX = aCluster % clustersX;
+		int clusterY = aCluster / clustersX;
+
+		cluster.nodes = eastTransitions[static_cast< std::size_t >( aCluster)];
+		cluster.nodes.insert( cluster.nodes.end(), southTransitions[static_cast< std::size_t >( aCluster)].begin(), southTransitions[static_cast< std::size_t >( aCluster)].end());
+		if (clusterX > 0)
+		{
+			for (const wxPoint& cell : eastTransitions[static_cast< std::size_t >( aCluster - 1)])
+			{
+				cluster.nodes.push_back( wxPoint( cell.x + 1, cell.y));
+			}
+		}
+		if (clusterY > 0)
+		{
+			for (const wxPoint& cell : southTransitions[static_cast< std::size_t >( aCluster - clustersX)])
+			{
+				cluster.nodes.push_back( wxPoint( cell.x, cell.y + 1));
+			}
+		}
+
+		// A corner cell may be on two borders
+		std::sort( cluster.nodes.begin(), cluster.nodes.end(), lessCell);
+		cluster.nodes.erase( std::unique( cluster.nodes.begin(), cluster.nodes.end()), cluster.nodes.end());
+
+		std::size_t count = cluster.nodes.size();
+		cluster.costs.assign( count * count, Infinity);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			expand( cluster.nodes[i], nullptr);
+			for (std::size_t j = 0; j < count; ++j)
+			{
+				cluster.costs[i * count + j] = localCosts[static_cast< std::size_t >( (cluster.nodes[j].y - localTop) * localWidth + cluster.nodes[j].x - localLeft)];
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void ClusterGraph::rebuild( const std::vector< char >& aDirty)
+	{
+		// A changed cluster changes the entrances on all its borders and so the nodes of its neighbours
+		std::vector< char > affected( clusters.size(), 0);
+		for (int cluster = 0; cluster < static_cast< int >( clusters.size()); ++cluster)
+		{
+			if (!aDirty[static_cast< std::size_t >( cluster)])
+			{
+				continue;
+			}
+			int clusterX = cluster % clustersX;
+			int clusterY = cluster / clustersX;
+
+			findTransitions( cluster, false);
+			findTransitions( cluster, true);
+			affected[static_cast< std::size_t >( cluster)] = 1;
+			if (clusterX > 0)
+			{
+				findTransitions( cluster - 1, false);
+				affected[static_cast< std::size_t >( cluster - 1)] = 1;
+			}
+			if (clusterY > 0)
+			{
+				findTransitions( cluster - clustersX, true);
+				affected[static_cast< std::size_t >( cluster - clustersX)] = 1;
+			}
+			if (clusterX + 1 < clustersX)
+			{
+				affected[static_cast< std::size_t >( cluster + 1)] = 1;
+			}
+			if (clusterY + 1 < clustersY)
+			{
+				affected[static_cast< std::size_t >( cluster + clustersX)] = 1;
+			}
+		}
+
+		rebuiltClusterCount = 0;
+		for (int cluster = 0; cluster < static_cast< int >( clusters.size()); ++cluster)
+		{
+			if (affected[static_cast< std::size_t >( cluster)])
+			{
+				buildCluster( cluster);
+				++rebuiltClusterCount;
+			}
+		}
+
+		link();
+	}
+	/**
+	 *
+	 */
+	void ClusterGraph::link()
+	{
+		firstNodes.resize( clusters.size() + 1);
+		nodeClusters.clear();
+		for (std::size_t cluster = 0; cluster < clusters.size(); ++cluster)
+		{
+			firstNodes[cluster] = static_cast< std::int32_t >( nodeClusters.size());
+			nodeClusters.insert( nodeClusters.end(), clusters[cluster].nodes.size(), static_cast< std::int32_t >( cluster));
+		}
+		firstNodes[clusters.size()] = static_cast< std::int32_t >( nodeClusters.size());
+
+		// Every transition links two nodes both ways, count them first and then fill them in
+		auto forEachTransition = [this]( const std::function< void( std::int32_t, std::int32_t) >& aFunction)
+		{
+			for (int cluster = 0; cluster < static_cast< int >( clusters.size()); ++cluster)
+			{
+				for (const wxPoint& cell : eastTransitions[static_cast< std::size_t >( cluster)])
+				{
+					aFunction( findNode( cluster, cell), findNode( cluster + 1, wxPoint( cell.x + 1, cell.y)));
+				}
+				for (const wxPoint& cell : southTransitions[static_cast< std::size_t >( cluster)])
+				{
+					aFunction( findNode( cluster, cell), findNode( cluster + clustersX, wxPoint( cell.x, cell.y + 1)));
+				}
+			}
+		};
+
+		firstLinks.assign( nodeClusters.size() + 1, 0);
+		forEachTransition( [this]( std::int32_t aNode, std::int32_t anOtherNode)
+		{
+			++firstLinks[static_cast< std::size_t >( aNode) + 1];
+			++firstLinks[static_cast< std::size_t >( anOtherNode) + 1];
+		});
+		for (std::size_t i = 1; i < firstLinks.size(); ++i)
+		{
+			firstLinks[i] += firstLinks[i - 1];
+		}
+
+		links.resize( static_cast< std::size_t >( firstLinks.back()));
+		std::vector< std::int32_t > next( firstLinks.begin(), firstLinks.end() - 1);
+		forEachTransition( [this, &next]( std::int32_t aNode, std::int32_t anOtherNode)
+		{
+			links[static_cast< std::size_t >( next[static_cast< std::size_t >( aNode)]++)] = anOtherNode;
+			links[static_cast< std::size_t >( next[static_cast< std::size_t >( anOtherNode)]++)] = aNode;
+		});
+	}
+	/**
+	 *
+	 */
+	std::int32_t ClusterGraph::findNode(	int aCluster,
+											const wxPoint& aCell) const
+	{
+		const std::vector< wxPoint >& nodes = clusters[static_cast< std::size_t >( aCluster)].nodes;
+		auto i = std::lower_bound( nodes.begin(), nodes.end(), aCell, lessCell);
+		return firstNodes[static_cast< std::size_t >( aCluster)] + static_cast< std::int32_t >( i - nodes.begin());
+	}
+	/**
+	 *
+	 */
+	bool ClusterGraph::expand(	const wxPoint& aFrom,
+								const wxPoint* aTo)
+	{
+
+		int cluster = getCluster( aFrom.x, aFrom.y);
+		localLeft = left + (cluster % clustersX) * clusterSize;
+		localTop = top + (cluster / clustersX) * clusterSize;
+		localWidth = std::min( clusterSize, left + width - localLeft);
+		int localHeight = std::min( clusterSize, top + height - localTop);
+
+		std::size_t cellCount = static_cast< std::size_t >( localWidth * localHeight);
+		localCosts.assign( cellCount, Infinity);
+		localPredecessors.assign( cellCount, -1);
+		localQueue.clear();
+
+		std::int32_t from = (aFrom.y - localTop) * localWidth + aFrom.x - localLeft;
+		std::int32_t to = aTo ? (aTo->y - localTop) * localWidth + aTo->x - localLeft : -1;
+
+		localCosts[static_cast< std::size_t >( from)] = 0.0;
+		localQueue.push_back( std::make_pair( 0.0, from));
+		while (!localQueue.empty())
+		{
+			std::pair< double, std::int32_t > current = localQueue.front();
+			std::pop_heap( localQueue.begin(), localQueue.end(), std::greater< std::pair< double, std::int32_t > >());
+			localQueue.pop_back();
+
+			if (current.first > localCosts[static_cast< std::size_t >( current.second)])
+			{
+				continue;
+			}
+			if (current.second == to)
+			{
+				return true;
+			}
+
+			int x = current.second % localWidth;
+			int y = current.second / localWidth;
+			for (int i = 0; i < OccupancyGrid::DirectionCount; ++i)
+			{
+				int neighbourX = x + OccupancyGrid::XOffset[i];
+				int neighbourY = y + OccupancyGrid::YOffset[i];
+				if (neighbourX < 0 || neighbourX >= localWidth || neighbourY < 0 || neighbourY >= localHeight ||
+					occupancyGrid->isBlocked( localLeft + neighbourX, localTop + neighbourY))
+				{
+					continue;
+				}
+				std::int32_t neighbour = neighbourY * localWidth + neighbourX;
+				double cost = current.first + OccupancyGrid::StepCost[i];
+				if (cost < localCosts[static_cast< std::size_t >( neighbour)])
+				{
+					localCosts[static_cast< std::size_t >( neighbour)] = cost;
+					localPredecessors[static_cast< std::size_t >( neighbour)] = current.second;
+					localQueue.push_back( std::make_pair( cost, neighbour));
+					std::push_heap( localQueue.begin(), localQueue.end(), std::greater< std::pair< double, std::int32_t > >());
+				}
+			}
+		}
+		return aTo == nullptr;
+	}
+	/**
+	 *
+	 */
+	bool ClusterGraph::refine(	const wxPoint& aFrom,
+								const wxPoint& aTo,
+								std::vector< Vertex >& aPath)
+	{
+		if (aFrom == aTo)
+		{
+			return true;
+		}
+		if (!expand( aFrom, &aTo))
+		{
+			return false;
+		}
+
+		// Count first so the cells are filled back to front without any copying
+		std::int32_t from = (aFrom.y - localTop) * localWidth + aFrom.x - localLeft;
+		std::int32_t to = (aTo.y - localTop) * localWidth + aTo.x - localLeft;
+		std::size_t length = 0;
+		for (std::int32_t cell = to; cell != from; cell = localPredecessors[static_cast< std::size_t >( cell)])
+		{
+			++length;
+		}
+
+		std::size_t i = aPath.size() + length;
+		aPath.resize( i, Vertex( 0, 0));
+		for (std::int32_t cell = to; cell != from; cell = localPredecessors[static_cast< std::size_t >( cell)])
+		{
+			aPath[--i] = Vertex( localLeft + cell % localWidth, localTop + cell / localWidth);
+		}
+		return true;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,197 @@
+#ifndef CLUSTERGRAPH_HPP_
+#define CLUSTERGRAPH_HPP_
+
+#include "Config.hpp"
+
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * The ClusterGraph is the abstract graph of a hierarchical path planner (HPA*, Botea, Müller and
+	 * Schaeffer, 2004). The OccupancyGrid is partitioned into square clusters. Where the free cells on
+	 * both sides of the border of two clusters form an entrance, one or two transitions are placed. The
+	 * cells of the transitions are the nodes of the graph: nodes in the same cluster are connected with
+	 * their precomputed cost inside the cluster, the two cells of a transition are connected with cost 1.
+	 *
+	 * A path is found on the abstract graph first and only then refined inside the clusters it crosses.
+	 * The path is not necessarily optimal, but the cost of a search hardly depends on the size of the world.
+	 *
+	 * When walls change only the clusters that were touched by the OccupancyGrid, and their neighbours
+	 * whose entrances may have changed, are rebuilt.
+	 */
+	class ClusterGraph
+	{
+		public:
+			/**
+			 *
+			 */
+			static constexpr int NoCluster = -1;
+			/**
+			 *
+			 */
+			explicit ClusterGraph( int aClusterSize = 32);
+			/**
+			 * Brings the graph up to date with anOccupancyGrid, which must be kept alive and unchanged
+			 * until the next update.
+			 */
+			void update( const OccupancyGrid& anOccupancyGrid);
+			/**
+			 * Finds a path from aStart to aGoal. The path contains every cell, the actual costs are not set.
+			 *
+			 * @return false if the start or the goal is not in a free cell of the graph or if there is no path
+			 */
+			bool findPath(	const Vertex& aStart,
+							const Vertex& aGoal,
+							std::vector< Vertex >& aPath);
+			/**
+			 *
+			 * @return the index of the cluster of (anX,anY) or NoCluster if the point is outside the graph
+			 */
+			int getCluster(	int anX,
+							int anY) const;
+			/**
+			 *
+			 */
+			int getClusterCount() const
+			{
+				return static_cast< int >( clusters.size());
+			}
+			/**
+			 *
+			 */
+			std::size_t getNodeCount() const
+			{
+				return nodeClusters.size();
+			}
+			/**
+			 * The number of clusters that were rebuilt by the latest update() that changed anything
+			 */
+			int getRebuiltClusterCount() const
+			{
+				return rebuiltClusterCount;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			struct Cluster
+			{
+				/**
+				 * The cells of the transitions in this cluster, sorted on y and then on x
+				 */
+				std::vector< wxPoint > nodes;
+				/**
+				 * The cost between every pair of nodes, infinity if there is no path inside the cluster
+				 */
+				std::vector< double > costs;
+			};
+			/**
+			 * Finds the transitions on the border to the cluster to the east (aSouth false) or to the south
+			 */
+			void findTransitions(	int aCluster,
+									bool aSouth);
+			/**
+			 * Collects the nodes of the cluster from its four borders and computes their costs
+			 */
+			void buildCluster( int aCluster);
+			/**
+			 * Rebuilds the clusters that are marked dirty and the neighbours of those
+			 */
+			void rebuild( const std::vector< char >& aDirty);
+			/**
+			 * Numbers the nodes of all clusters and connects the two nodes of every transition
+			 */
+			void link();
+			/**
+			 *
+			 * @return the global number of the node at aCell of aCluster
+			 */
+			std::int32_t findNode(	int aCluster,
+									const wxPoint& aCell) const;
+			/**
+			 * Dijkstra from aFrom inside its cluster, stops when aTo is found if it is not nullptr
+			 *
+			 * @return true if aTo is nullptr or if it was found
+			 */
+			bool expand(	const wxPoint& aFrom,
+							const wxPoint* aTo);
+			/**
+			 * Appends the cells after aFrom up to and including aTo to aPath, both must be in the same cluster
+			 */
+			bool refine(	const wxPoint& aFrom,
+							const wxPoint& aTo,
+							std::vector< Vertex >& aPath);
+			/**
+			 *
+			 */
+			bool isBlocked( const wxPoint& aCell) const
+			{
+				return occupancyGrid->isBlocked( aCell.x, aCell.y);
+			}
+
+			int clusterSize;
+			const OccupancyGrid* occupancyGrid;
+			unsigned long geometryVersion;
+			unsigned long rebuildCount;
+			int rebuiltClusterCount;
+			/**
+			 * The bounds of the graph, those of the OccupancyGrid
+			 */
+			int left;
+			int top;
+			int width;
+			int height;
+			int clustersX;
+			int clustersY;
+			/**
+			 *
+			 */
+			std::vector< Cluster > clusters;
+			/**
+			 * The western or northern cells of the transitions on the eastern and southern border of every cluster
+			 */
+			std::vector< std::vector< wxPoint > > eastTransitions;
+			std::vector< std::vector< wxPoint > > southTransitions;
+			/**
+			 * The global number of the first node of every cluster, the number of nodes at the end
+			 */
+			std::vector< std::int32_t > firstNodes;
+			/**
+			 * The cluster of every node
+			 */
+			std::vector< std::int32_t > nodeClusters;
+			/**
+			 * The other side(s) of the transitions of every node, firstLinks[node] is the first of the node
+			 */
+			std::vector< std::int32_t > firstLinks;
+			std::vector< std::int32_t > links;
+			/**
+			 * Reused storage for the searches inside a cluster
+			 */
+			int localLeft;
+			int localTop;
+			int localWidth;
+			std::vector< double > localCosts;
+			std::vector< std::int32_t > localPredecessors;
+			std::vector< std::pair< double, std::int32_t > > localQueue;
+			/**
+			 * Reused storage for the searches on the abstract graph
+			 */
+			std::vector< double > startCosts;
+			std::vector< double > goalCosts;
+			std::vector< double > abstractCosts;
+			std::vector< std::int32_t > abstractPredecessors;
+			std::vector< char > abstractClosed;
+			std::vector< std::pair< double, std::int32_t > > abstractQueue;
+			std::vector< std::int32_t > abstractPath;
+	}; // class ClusterGraph
+} // namespace PathAlgorithm
+#endif // CLUSTERGRAPH_HPP_
@@ -0,0 +1,87 @@
+#include "CompactPath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		std::int16_t Pack( int aCoordinate)
+		{
+			if (aCoordinate < std::numeric_limits< std::int16_t >::min() || aCoordinate > std::numeric_limits< std::int16_t >::max())
+			{
+				throw std::out_of_range( "Coordinate " + std::to_string( aCoordinate) + " does not fit in a CompactPath");
+			}
+			return static_cast< std::int16_t >( aCoordinate);
+		}
+		/**
+		 *
+		 */
+		double Distance(	const wxPoint& aFrom,
+							const wxPoint& aTo)
+		{
+			return std::hypot( aTo.x - aFrom.x, aTo.y - aFrom.y);
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	CompactPath::CompactPath( const std::vector< Vertex >& aPath)
+	{
+		points.reserve( aPath.size());
+		for (const Vertex& vertex : aPath)
+		{
+			points.push_back( Point16{ Pack( vertex.x), Pack( vertex.y)});
+		}
+		for (std::size_t i = 1; i < points.size(); ++i)
+		{
+			length += Distance( (*this)[i - 1], (*this)[i]);
+		}
+	}
+	/**
+	 *
+	 */
+	CompactPath::Cursor::Cursor( const CompactPath& aPath) :
+		path( aPath),
+		next( 1),
+		lineStart( 0.0),
+		lineLength( aPath.size() > 1 ? Distance( aPath[0], aPath[1]) : 0.0),
+		distance( 0.0)
+	{
+	}
+	/**
+	 *
+	 */
+	wxPoint CompactPath::Cursor::advance( double aDistance)
+	{
+		if (isAtEnd())
+		{
+			return path.empty() ? wxPoint( 0, 0) : path.back();
+		}
+
+		distance += aDistance;
+		while (next + 1 < path.size() && distance >= lineStart + lineLength)
+		{
+			lineStart += lineLength;
+			++next;
+			lineLength = Distance( path[next - 1], path[next]);
+		}
+
+		wxPoint from = path[next - 1];
+		wxPoint to = path[next];
+		double fraction = lineLength > 0.0 ? std::min( (distance - lineStart) / lineLength, 1.0) : 1.0;
+		if (fraction >= 1.0 && next + 1 == path.size())
+		{
+			++next;
+		}
+		return wxPoint( static_cast< int >( std::lround( from.x + (to.x - from.x) * fraction)),
+						static_cast< int >( std::lround( from.y + (to.y - from.y) * fraction)));
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,255 @@
+#ifndef COMPACTPATH_HPP_
+#define COMPACTPATH_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+#include "Vertex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	class CompactPath;
+	typedef std::shared_ptr< const CompactPath > CompactPathPtr;
+
+	/**
+	 * A CompactPath is a route after planning: only the points, packed in 16 bits per coordinate, without the
+	 * costs of the search. It never changes once made, so the robot that drives it and the shape that draws it
+	 * share the same one through a CompactPathPtr instead of copying it.
+	 */
+	class CompactPath
+	{
+		public:
+			/**
+			 *
+			 */
+			struct Point16
+			{
+				std::int16_t x;
+				std::int16_t y;
+			};
+			/**
+			 * Iterates over the points of the path as wxPoints
+			 */
+			class const_iterator
+			{
+				public:
+					typedef std::random_access_iterator_tag iterator_category;
+					typedef wxPoint value_type;
+					typedef std::ptrdiff_t difference_type;
+					typedef const wxPoint* pointer;
+					typedef wxPoint reference;
+					/**
+					 *
+					 */
+					explicit const_iterator( const Point16* aPoint = nullptr) :
+						point( aPoint)
+					{
+					}
+					/**
+					 *
+					 */
+					wxPoint operator*() const
+					{
+						return wxPoint( point->x, point->y);
+					}
+					/**
+					 *
+					 */
+					wxPoint operator[]( difference_type anOffset) const
+					{
+						return wxPoint( point[anOffset].x, point[anOffset].y);
+					}
+					/**
+					 *
+					 */
+					const_iterator& operator++()
+					{
+						++point;
+						return *this;
+					}
+					const_iterator operator++( int)
+					{
+						return const_iterator( point++);
+					}
+					const_iterator& operator--()
+					{
+						--point;
+						return *this;
+					}
+					const_iterator operator--( int)
+					{
+						return const_iterator( point--);
+					}
+					const_iterator& operator+=( difference_type anOffset)
+					{
+						point += anOffset;
+						return *this;
+					}
+					const_iterator& operator-=( difference_type anOffset)
+					{
+						point -= anOffset;
+						return *this;
+					}
+					const_iterator operator+( difference_type anOffset) const
+					{
+						return const_iterator( point + anOffset);
+					}
+					const_iterator operator-( difference_type anOffset) const
+					{
+						return const_iterator( point - anOffset);
+					}
+					difference_type operator-( const const_iterator& anOther) const
+					{
+						return point - anOther.point;
+					}
+					/**
+					 *
+					 */
+					bool operator==( const const_iterator& anOther) const
+					{
+						return point == anOther.point;
+					}
+					bool operator!=( const const_iterator& anOther) const
+					{
+						return point != anOther.point;
+					}
+					bool operator<( const const_iterator& anOther) const
+					{
+						return point < anOther.point;
+					}
+
+				private:
+					const Point16* point;
+			}; // class const_iterator
+			/**
+			 * Walks along the straight lines between the points of a path. The path must outlive the Cursor.
+			 */
+			class Cursor
+			{
+				public:
+					/**
+					 *
+					 */
+					explicit Cursor( const CompactPath& aPath);
+					/**
+					 * Moves aDistance further along the path, but not beyond its end
+					 *
+					 * @return the point at the new position, rounded to the nearest pixel
+					 */
+					wxPoint advance( double aDistance);
+					/**
+					 *
+					 * @return true if the end of the path has been reached
+					 */
+					bool isAtEnd() const
+					{
+						return next >= path.size();
+					}
+					/**
+					 * The number of points of the path that have been reached, the first one from the start
+					 */
+					std::size_t getReachedCount() const
+					{
+						return std::min( next, path.size());
+					}
+
+				private:
+					const CompactPath& path;
+					/**
+					 * The point at the end of the current line
+					 */
+					std::size_t next;
+					/**
+					 * The distance along the path at the start of the current line and the length of that line
+					 */
+					double lineStart;
+					double lineLength;
+					double distance;
+			}; // class Cursor
+			/**
+			 *
+			 */
+			CompactPath() = default;
+			/**
+			 * Packs the points of aPath
+			 *
+			 * @throws std::out_of_range if a coordinate does not fit in 16 bits
+			 */
+			explicit CompactPath( const std::vector< Vertex >& aPath);
+			/**
+			 *
+			 */
+			std::size_t size() const
+			{
+				return points.size();
+			}
+			/**
+			 *
+			 */
+			bool empty() const
+			{
+				return points.empty();
+			}
+			/**
+			 *
+			 */
+			wxPoint operator[]( std::size_t anIndex) const
+			{
+				return wxPoint( points[anIndex].x, points[anIndex].y);
+			}
+			/**
+			 *
+			 */
+			wxPoint front() const
+			{
+				return (*this)[0];
+			}
+			/**
+			 *
+			 */
+			wxPoint back() const
+			{
+				return (*this)[points.size() - 1];
+			}
+			/**
+			 *
+			 */
+			const_iterator begin() const
+			{
+				return const_iterator( points.data());
+			}
+			/**
+			 *
+			 */
+			const_iterator end() const
+			{
+				return const_iterator( points.data() + points.size());
+			}
+			/**
+			 * @return the length of the straight lines between the points
+			 */
+			double getLength() const
+			{
+				return length;
+			}
+			/**
+			 *
+			 */
+			Cursor getCursor() const
+			{
+				return Cursor( *this);
+			}
+
+		private:
+			std::vector< Point16 > points;
+			double length = 0.0;
+	}; // class CompactPath
+} // namespace PathAlgorithm
+#endif // COMPACTPATH_HPP_
@@ -0,0 +1,173 @@
+#include "CooperativeAStar.hpp"
+
+#include "AStar.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 * The moves, the directions of the OccupancyGrid and then waiting
+		 */
+		const int Moves = OccupancyGrid::DirectionCount + 1;
+		/**
+		 * A state as (lattice x, lattice y, time), 20 bits each for the position and 24 for the time
+		 */
+		std::uint64_t StateKey(	int aLatticeX,
+								int aLatticeY,
+								ReservationTable::Tick aTime)
+		{
+			return (static_cast< std::uint64_t >( aLatticeX & 0xFFFFF) << 44) |
+				   (static_cast< std::uint64_t >( aLatticeY & 0xFFFFF) << 24) |
+				   (static_cast< std::uint64_t >( aTime) & 0xFFFFFF);
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	CooperativeAStar::CooperativeAStar( std::size_t aMaxExpansions) :
+		maxExpansions( aMaxExpansions),
+		expansionCount( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	bool CooperativeAStar::plan(	const void* anOwner,
+									const wxPoint& aStart,
+									const wxPoint& aGoal,
+									const wxSize& aRobotSize,
+									int aStep,
+									ReservationTable::Tick& aStartTick,
+									std::vector< wxPoint >& aPositions)
+	{
+		expansionCount = 0;
+		nodes.clear();
+		openSet.clear();
+		visited.clear();
+
+		CostFieldPtr costField = CostField::getCostField( aGoal, aRobotSize);
+		double startCost = costField->getCost( aStart.x, aStart.y);
+		if (std::isinf( startCost))
+		{
+			return false;
+		}
+		int step = std::max( aStep, 1);
+		int radius = costField->getFreeRadius();
+		// Waiting makes the space-time graph infinite, the route may take a few times the ticks of the shortest one
+		ReservationTable::Tick maxTime = static_cast< ReservationTable::Tick >( 4.0 * startCost / step) + 200;
+		double reach = step * std::sqrt( 2.0);
+
+		ReservationTable& reservationTable = ReservationTable::getReservationTable();
+		std::unique_lock< std::recursive_mutex > lock = reservationTable.lock();
+		ReservationTable::Tick startTick = reservationTable.getCurrentTick();
+		// A robot that stays at the goal for good can not be waited for
+		if (!reservationTable.isFreeFrom( anOwner, aGoal, radius, std::numeric_limits< ReservationTable::Tick >::max()))
+		{
+			return false;
+		}
+
+		// The ticks still needed: every tick but the last one lowers the cost-to-go by at most a diagonal step and
+		// the larger distance along an axis by at most the step. The last one jumps at most reach to the goal,
+		// which costs at most reach times the square root of 4 - 2 * sqrt( 2) along the 8 directions of the grid.
+		const double diagonal = step * std::sqrt( 2.0);
+		const double lastCost = reach * std::sqrt( 4.0 - 2.0 * std::sqrt( 2.0));
+		const auto heuristic = [&]( const wxPoint& aPoint)
+		{
+			double cost = costField->getCost( aPoint.x, aPoint.y);
+			double distance = std::max( std::abs( aGoal.x - aPoint.x), std::abs( aGoal.y - aPoint.y));
+			return 1.0 + std::max( { 0.0, (cost - lastCost) / diagonal, (distance - reach) / step });
+		};
+		const auto greater = std::greater< std::pair< double, std::int32_t > >();
+
+		visited.insert( StateKey( 0, 0, 0));
+		addNode( aStart, 0, -1, heuristic( aStart));
+		while (!openSet.empty() && expansionCount < maxExpansions)
+		{
+			std::pop_heap( openSet.begin(), openSet.end(), greater);
+			std::int32_t current = openSet.back().second;
+			openSet.pop_back();
+			++expansionCount;
+
+			wxPoint point = nodes[static_cast< std::size_t >( current)].point;
+			ReservationTable::Tick time = nodes[static_cast< std::size_t >( current)].time;
+			ReservationTable::Tick nextTick = startTick + time + 1;
+
+			double dx = aGoal.x - point.x;
+			double dy = aGoal.y - point.y;
+			if (std::sqrt( dx * dx + dy * dy) <= reach &&
+				costField->isLineFree( point, aGoal) &&
+				reservationTable.isFree( anOwner, aGoal, radius, nextTick) &&
+				reservationTable.isFreeFrom( anOwner, aGoal, radius, nextTick))
+			{
+				aStartTick = startTick;
+				constructRoute( current, aGoal, aPositions);
+				reservationTable.reserve( anOwner, startTick, aPositions, radius);
+				return true;
+			}
+			if (time >= maxTime)
+			{
+				continue;
+			}
+			for (int move = 0; move < Moves; ++move)
+			{
+				bool waiting = move == Moves - 1;
+				wxPoint next( point.x + (waiting ? 0 : OccupancyGrid::XOffset[move] * step), point.y + (waiting ? 0 : OccupancyGrid::YOffset[move] * step));
+				if (!visited.insert( StateKey( (next.x - aStart.x) / step, (next.y - aStart.y) / step, time + 1)).second)
+				{
+					continue;
+				}
+				double nextHeuristic = heuristic( next);
+				if (std::isinf( nextHeuristic) || (!waiting && !costField->isLineFree( point, next)))
+				{
+					continue;
+				}
+				if (!reservationTable.isFree( anOwner, next, radius, nextTick))
+				{
+					continue;
+				}
+				addNode( next, time + 1, current, nextHeuristic);
+			}
+		}
+		return false;
+	}
+	/**
+	 *
+	 */
+	std::int32_t CooperativeAStar::addNode(	const wxPoint& aPoint,
+											ReservationTable::Tick aTime,
+											std::int32_t aParent,
+											double aHeuristic)
+	{
+		std::int32_t node = static_cast< std::int32_t >( nodes.size());
+		nodes.push_back( Node{ aPoint, aTime, aParent });
+		// Every move takes one tick so the cost so far is the time, on equal estimates the later state goes first
+		openSet.emplace_back( static_cast< double >( aTime) + aHeuristic - static_cast< double >( aTime) * 1e-6, node);
+		std::push_heap( openSet.begin(), openSet.end(), std::greater< std::pair< double, std::int32_t > >());
+		return node;
+	}
+	/**
+	 *
+	 */
+	void CooperativeAStar::constructRoute(	std::int32_t aNode,
+											const wxPoint& aGoal,
+											std::vector< wxPoint >& aPositions) const
+	{
+		aPositions.clear();
+		for (std::int32_t node = aNode; node != -1; node = nodes[static_cast< std::size_t >( node)].parent)
+		{
+			aPositions.push_back( nodes[static_cast< std::size_t >( node)].point);
+		}
+		std::reverse( aPositions.begin(), aPositions.end());
+		if (aPositions.back() != aGoal)
+		{
+			aPositions.push_back( aGoal);
+		}
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,91 @@
+#ifndef COOPERATIVEASTAR_HPP_
+#define COOPERATIVEASTAR_HPP_
+
+#include "Config.hpp"
+
+#include "CostField.hpp"
+#include "Point.hpp"
+#include "ReservationTable.hpp"
+#include "Size.hpp"
+
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * CooperativeAStar plans the route of one robot in space and time around the routes that the other robots
+	 * reserved before (Cooperative A*, Silver 2005). A state is a position at a tick. Every tick the robot
+	 * either makes one step in one of the 8 directions of the OccupancyGrid or waits, so the route is conflict
+	 * free by construction instead of being repaired by evading when robots meet.
+	 *
+	 * The positions lie on a lattice anchored at the start with the step as spacing, a step moves the step
+	 * along each axis it moves along, so a diagonal step is the square root of 2 times as long. The cost-to-go
+	 * of the CostField to the goal, which ignores the other robots, gives the heuristic in ticks and tells
+	 * which positions are free of walls. The goal is reached when it is within one step and no other robot will come there later.
+	 */
+	class CooperativeAStar
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit CooperativeAStar( std::size_t aMaxExpansions = 200000);
+			/**
+			 * Plans a route from aStart to aGoal that starts now and reserves it for anOwner. The route has a
+			 * position for every tick from aStartTick on, the last one is aGoal.
+			 *
+			 * @return false if there is no route within the budget, the reservation of anOwner is then unchanged
+			 */
+			bool plan(	const void* anOwner,
+						const wxPoint& aStart,
+						const wxPoint& aGoal,
+						const wxSize& aRobotSize,
+						int aStep,
+						ReservationTable::Tick& aStartTick,
+						std::vector< wxPoint >& aPositions);
+			/**
+			 * The number of states expanded by the latest plan()
+			 */
+			std::size_t getExpansionCount() const
+			{
+				return expansionCount;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			struct Node
+			{
+				wxPoint point;
+				ReservationTable::Tick time;
+				std::int32_t parent;
+			};
+			/**
+			 *
+			 */
+			std::int32_t addNode(	const wxPoint& aPoint,
+									ReservationTable::Tick aTime,
+									std::int32_t aParent,
+									double aHeuristic);
+			/**
+			 *
+			 */
+			void constructRoute(	std::int32_t aNode,
+									const wxPoint& aGoal,
+									std::vector< wxPoint >& aPositions) const;
+
+			std::size_t maxExpansions;
+			std::size_t expansionCount;
+			/**
+			 * Reused storage of the searches
+			 */
+			std::vector< Node > nodes;
+			std::vector< std::pair< double, std::int32_t > > openSet;
+			std::unordered_set< std::uint64_t > visited;
+	}; // class CooperativeAStar
+} // namespace PathAlgorithm
+#endif // COOPERATIVEASTAR_HPP_
@@ -0,0 +1,196 @@
+#include "CostField.hpp"
+
+#include "FieldCache.hpp"
+#include "RobotWorld.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		const float Infinity = std::numeric_limits< float >::infinity();
+
+		/**
+		 * The step costs of the OccupancyGrid in the precision of the field
+		 */
+		const float stepCost[] = {	static_cast< float >( OccupancyGrid::StepCost[0]), static_cast< float >( OccupancyGrid::StepCost[1]),
+									static_cast< float >( OccupancyGrid::StepCost[2]), static_cast< float >( OccupancyGrid::StepCost[3]),
+									static_cast< float >( OccupancyGrid::StepCost[4]), static_cast< float >( OccupancyGrid::StepCost[5]),
+									static_cast< float >( OccupancyGrid::StepCost[6]), static_cast< float >( OccupancyGrid::StepCost[7]) };
+	} // namespace
+	/**
+	 *
+	 */
+	/* static */ CostFieldPtr CostField::getCostField(	const wxPoint& aGoal,
+														const wxSize& aRobotSize)
+	{
+		// One field per goal and robot size
+		static FieldCache< CostField > costFields;
+
+		const Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		unsigned long geometryVersion = robotWorld.getGeometryVersion();
+		int freeRadius = AStar::getFreeRadius( aRobotSize);
+
+		return costFields.get(	geometryVersion,
+								[&aGoal, freeRadius]( const CostFieldPtr& aCostField)
+								{
+									return aCostField->getGoal() == aGoal && aCostField->getFreeRadius() == freeRadius;
+								},
+								[&robotWorld, &aGoal, freeRadius, geometryVersion]()
+								{
+									OccupancyGrid occupancyGrid;
+									occupancyGrid.synchronise( robotWorld.getWalls(), freeRadius, geometryVersion);
+									return std::make_shared< const CostField >( occupancyGrid, aGoal, geometryVersion);
+								});
+	}
+	/**
+	 *
+	 */
+	CostField::CostField(	const OccupancyGrid& anOccupancyGrid,
+							const wxPoint& aGoal,
+							unsigned long aGeometryVersion) :
+		occupancyGrid( anOccupancyGrid),
+		goal( aGoal),
+		geometryVersion( aGeometryVersion)
+	{
+		// The walls and the goal, with room to drive around the end of a wall like AStar
+		int margin = occupancyGrid.getFreeRadius() + 1;
+		int right = aGoal.x;
+		int bottom = aGoal.y;
+		left = aGoal.x;
+		top = aGoal.y;
+		if (occupancyGrid.getWidth() > 0 && occupancyGrid.getHeight() > 0)
+		{
+			left = std::min( left, occupancyGrid.getLeft());
+			top = std::min( top, occupancyGrid.getTop());
+			right = std::max( right, occupancyGrid.getLeft() + occupancyGrid.getWidth() - 1);
+			bottom = std::max( bottom, occupancyGrid.getTop() + occupancyGrid.getHeight() - 1);
+		}
+		left -= margin;
+		top -= margin;
+		width = right - left + margin + 1;
+		height = bottom - top + margin + 1;
+
+		costs.assign( static_cast< std::size_t >( width) * static_cast< std::size_t >( height), Infinity);
+
+		std::int32_t goalCell = cellIndex( aGoal.x, aGoal.y);
+		if (occupancyGrid.isBlocked( aGoal.x, aGoal.y))
+		{
+			return;
+		}
+
+		// Dijkstra from the goal, the moves are symmetric so the costs to the goal are those from it
+		std::vector< std::pair< float, std::int32_t > > queue;
+		costs[static_cast< std::size_t >( goalCell)] = 0.0f;
+		queue.emplace_back( 0.0f, goalCell);
+		while (!queue.empty())
+		{
+			std::pop_heap( queue.begin(), queue.end(), std::greater< std::pair< float, std::int32_t > >());
+			std::pair< float, std::int32_t > current = queue.back();
+			queue.pop_back();
+			if (current.first > costs[static_cast< std::size_t >( current.second)])
+			{
+				continue;
+			}
+
+			int x = left + current.second % width;
+			int y = top + current.second / width;
+			unsigned int freeNeighbours = occupancyGrid.getFreeNeighbours( x, y);
+			for (int i = 0; freeNeighbours != 0; ++i, freeNeighbours >>= 1)
+			{
+				if (!(freeNeighbours & 1U))
+				{
+					continue;
+				}
+				std::int32_t neighbourCell = cellIndex( x + OccupancyGrid::XOffset[i], y + OccupancyGrid::YOffset[i]);
+				if (neighbourCell == -1)
+				{
+					continue;
+				}
+				float cost = current.first + stepCost[i];
+				if (cost < costs[static_cast< std::size_t >( neighbourCell)])
+				{
+					costs[static_cast< std::size_t >( neighbourCell)] = cost;
+					queue.emplace_back( cost, neighbourCell);
+					std::push_heap( queue.begin(), queue.end(), std::greater< std::pair< float, std::int32_t > >());
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	double CostField::getCost(	int anX,
+								int anY) const
+	{
+		std::int32_t cell = cellIndex( anX, anY);
+		return cell == -1 ? std::numeric_limits< double >::infinity() : costs[static_cast< std::size_t >( cell)];
+	}
+	/**
+	 *
+	 */
+	bool CostField::getPath(	const wxPoint& aStart,
+								Path& aPath) const
+	{
+		aPath.clear();
+
+		std::int32_t cell = cellIndex( aStart.x, aStart.y);
+		if (cell == -1 || costs[static_cast< std::size_t >( cell)] == Infinity)
+		{
+			return false;
+		}
+
+		// Every step goes to the neighbour through which the route is cheapest, until the goal is reached
+		wxPoint point = aStart;
+		aPath.push_back( Vertex( point));
+		while (costs[static_cast< std::size_t >( cell)] > 0.0f)
+		{
+			float best = costs[static_cast< std::size_t >( cell)];
+			std::int32_t next = -1;
+			int direction = 0;
+			for (int i = 0; i < OccupancyGrid::DirectionCount; ++i)
+			{
+				std::int32_t neighbourCell = cellIndex( point.x + OccupancyGrid::XOffset[i], point.y + OccupancyGrid::YOffset[i]);
+				if (neighbourCell != -1 && costs[static_cast< std::size_t >( neighbourCell)] + stepCost[i] <= best)
+				{
+					best = costs[static_cast< std::size_t >( neighbourCell)] + stepCost[i];
+					next = neighbourCell;
+					direction = i;
+				}
+			}
+			// Only the goal has no cheaper neighbour, but guard against rounding
+			if (next == -1 || costs[static_cast< std::size_t >( next)] >= costs[static_cast< std::size_t >( cell)])
+			{
+				break;
+			}
+			cell = next;
+			point.x += OccupancyGrid::XOffset[direction];
+			point.y += OccupancyGrid::YOffset[direction];
+			aPath.push_back( Vertex( point));
+		}
+
+		AStar::smoothPath( aPath, [this]( const Vertex& aFrom, const Vertex& aTo)
+						   {
+							   return occupancyGrid.isLineFree( aFrom.x, aFrom.y, aTo.x, aTo.y);
+						   });
+		return true;
+	}
+	/**
+	 *
+	 */
+	std::int32_t CostField::cellIndex(	int anX,
+										int anY) const
+	{
+		int column = anX - left;
+		int row = anY - top;
+		if (column < 0 || column >= width || row < 0 || row >= height)
+		{
+			return -1;
+		}
+		return row * width + column;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,129 @@
+#ifndef COSTFIELD_HPP_
+#define COSTFIELD_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	class CostField;
+	typedef std::shared_ptr< const CostField > CostFieldPtr;
+
+	/**
+	 * A CostField holds the cost of the shortest route from every cell to one goal for a robot with a given free
+	 * radius, computed once with Dijkstra from the goal. The route from any start is then found by following
+	 * the steepest descent of the costs, without a search. The fields are shared by all robots and are built
+	 * again only when the walls change, so any number of robots can compare the costs to every goal and drive
+	 * to the nearest one.
+	 *
+	 * The moves are the same as those of AStar.
+	 */
+	class CostField
+	{
+		public:
+			/**
+			 * @return the field to aGoal for a robot of aRobotSize and the walls as they are now
+			 */
+			static CostFieldPtr getCostField(	const wxPoint& aGoal,
+												const wxSize& aRobotSize);
+			/**
+			 * Computes the costs to aGoal for the walls of the synchronised anOccupancyGrid
+			 */
+			CostField(	const OccupancyGrid& anOccupancyGrid,
+						const wxPoint& aGoal,
+						unsigned long aGeometryVersion);
+			/**
+			 *
+			 * @return the cost of the shortest route from (anX,anY) to the goal, infinity if there is none
+			 */
+			double getCost(	int anX,
+							int anY) const;
+			/**
+			 * Writes the route from aStart to the goal, reduced to its corners, into aPath
+			 *
+			 * @return false if there is no route from aStart
+			 */
+			bool getPath(	const wxPoint& aStart,
+							Path& aPath) const;
+			/**
+			 *
+			 * @return true if a robot of the free radius of the field can drive straight from aFrom to aTo
+			 */
+			bool isLineFree(	const wxPoint& aFrom,
+								const wxPoint& aTo) const
+			{
+				return occupancyGrid.isLineFree( aFrom.x, aFrom.y, aTo.x, aTo.y);
+			}
+			/**
+			 *
+			 */
+			wxPoint getGoal() const
+			{
+				return goal;
+			}
+			/**
+			 *
+			 */
+			int getFreeRadius() const
+			{
+				return occupancyGrid.getFreeRadius();
+			}
+			/**
+			 *
+			 */
+			unsigned long getGeometryVersion() const
+			{
+				return geometryVersion;
+			}
+			/**
+			 * The bounds of the field, outside them there is no route
+			 */
+			int getLeft() const
+			{
+				return left;
+			}
+			int getTop() const
+			{
+				return top;
+			}
+			int getWidth() const
+			{
+				return width;
+			}
+			int getHeight() const
+			{
+				return height;
+			}
+
+		private:
+			/**
+			 *
+			 * @return the index of the cell of (anX,anY) or -1 if it is outside the field
+			 */
+			std::int32_t cellIndex(	int anX,
+									int anY) const;
+
+			OccupancyGrid occupancyGrid;
+			wxPoint goal;
+			unsigned long geometryVersion;
+			/**
+			 * The bounds of the field
+			 */
+			int left;
+			int top;
+			int width;
+			int height;
+			/**
+			 *
+			 */
+			std::vector< float > costs;
+	}; // class CostField
+} // namespace PathAlgorithm
+#endif // COSTFIELD_HPP_
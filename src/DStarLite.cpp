@@ -0,0 +1,549 @@
+#include "DStarLite.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		const double Infinity = std::numeric_limits< double >::infinity();
+	} // namespace
+	/**
+	 *
+	 */
+	DStarLite::DStarLite() :
+		valid( false),
+		left( 0),
+		top( 0),
+		width( 0),
+		height( 0),
+		rebuildCount( 0),
+		geometryVersion( 0),
+		freeRadius( 0),
+		goalCell( -1),
+		startCell( -1),
+		lastStartCell( -1),
+		keyModifier( 0.0)
+	{
+	}
+	/**
+	 *
+	 */
+	void DStarLite::search(	Vertex aStart,
+							const Vertex& aGoal,
+							const wxSize& aRobotSize,
+							Path& aPath)
+	{
+		aPath.clear();
+		getOS().clear();
+		resetSearchStats();
+
+		int radius = synchroniseOccupancyGrid( aRobotSize);
+		const OccupancyGrid& occupancyGrid = getOccupancyGrid();
+
+		bool boundsChanged = occupancyGrid.getRebuildCount() != rebuildCount || occupancyGrid.getLeft() != left ||
+							 occupancyGrid.getTop() != top || occupancyGrid.getWidth() != width || occupancyGrid.getHeight() != height;
+		// The changed areas of a synchronisation in between two searches, e.g. by startSearch(), are lost
+		bool versionsSkipped = occupancyGrid.getGeometryVersion() != geometryVersion && occupancyGrid.getChangedSinceVersion() != geometryVersion;
+		if (!valid || boundsChanged || versionsSkipped || radius != freeRadius || cellIndex( aGoal) != goalCell)
+		{
+			rebuildCount = occupancyGrid.getRebuildCount();
+			geometryVersion = occupancyGrid.getGeometryVersion();
+			left = occupancyGrid.getLeft();
+			top = occupancyGrid.getTop();
+			width = occupancyGrid.getWidth();
+			height = occupancyGrid.getHeight();
+			freeRadius = radius;
+			robotObstacles = newRobotObstacles;
+			reset( aGoal);
+		}
+
+		startCell = cellIndex( aStart);
+		if (goalCell == -1 || startCell == -1)
+		{
+			valid = false;
+			AStar::search( aStart, aGoal, aRobotSize, aPath);
+			return;
+		}
+
+		// The heuristic is relative to the start, the keys in the queue are corrected with the distance moved
+		std::int32_t previousStartCell = lastStartCell;
+		if (previousStartCell != -1)
+		{
+			int dx = (previousStartCell % width) - (startCell % width);
+			int dy = (previousStartCell / width) - (startCell / width);
+			keyModifier += std::sqrt( dx * dx + dy * dy);
+		}
+		lastStartCell = startCell;
+
+		processChanges();
+
+		// The start cell is never blocked, so the moves into the previous and the new start may have changed
+		if (previousStartCell != -1 && previousStartCell != startCell)
+		{
+			updateArea( left + previousStartCell % width, top + previousStartCell / width, left + previousStartCell % width, top + previousStartCell / width);
+			updateArea( left + startCell % width, top + startCell / width, left + startCell % width, top + startCell / width);
+		}
+
+		computeShortestPath();
+
+		if (!constructPath( aPath))
+		{
+			AStar::search( aStart, aGoal, aRobotSize, aPath);
+			return;
+		}
+		notifyProgress( true);
+	}
+	/**
+	 *
+	 */
+	void DStarLite::setRobotObstacles( const std::vector< wxPoint >& aPositions)
+	{
+		newRobotObstacles = aPositions;
+	}
+	/**
+	 *
+	 */
+	void DStarLite::reset( const Vertex& aGoal)
+	{
+		std::size_t cellCount = static_cast< std::size_t >( width) * static_cast< std::size_t >( height);
+
+		// assign() reuses the capacity of the previous searches
+		g.assign( cellCount, Infinity);
+		rhs.assign( cellCount, Infinity);
+		queuePositions.assign( cellCount, -1);
+		queue.clear();
+
+		keyModifier = 0.0;
+		startCell = -1;
+		lastStartCell = -1;
+		goalCell = cellIndex( aGoal);
+		valid = goalCell != -1;
+		if (valid)
+		{
+			rhs[static_cast< std::size_t >( goalCell)] = 0.0;
+			queuePush( goalCell, Key( heuristic( goalCell), 0.0));
+		}
+	}
+	/**
+	 *
+	 */
+	void DStarLite::processChanges()
+	{
+		const OccupancyGrid& occupancyGrid = getOccupancyGrid();
+		if (occupancyGrid.getGeometryVersion() != geometryVersion)
+		{
+			geometryVersion = occupancyGrid.getGeometryVersion();
+			for (const OccupancyGrid::Area& area : occupancyGrid.getChangedAreas())
+			{
+				updateArea( area.left, area.top, area.right, area.bottom);
+			}
+		}
+
+		if (newRobotObstacles != robotObstacles)
+		{
+			// Only the robots that moved, first take the old ones away and then put the new ones in
+			std::vector< wxPoint > oldRobotObstacles;
+			std::swap( oldRobotObstacles, robotObstacles);
+			robotObstacles = newRobotObstacles;
+
+			for (const wxPoint& position : oldRobotObstacles)
+			{
+				if (std::find( robotObstacles.begin(), robotObstacles.end(), position) == robotObstacles.end())
+				{
+					updateArea( position.x - freeRadius, position.y - freeRadius, position.x + freeRadius, position.y + freeRadius);
+				}
+			}
+			for (const wxPoint& position : robotObstacles)
+			{
+				if (std::find( oldRobotObstacles.begin(), oldRobotObstacles.end(), position) == oldRobotObstacles.end())
+				{
+					updateArea( position.x - freeRadius, position.y - freeRadius, position.x + freeRadius, position.y + freeRadius);
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void DStarLite::updateArea(	int aLeft,
+								int aTop,
+								int aRight,
+								int aBottom)
+	{
+		// The cells around the area have moves into it
+		int firstX = std::max( aLeft - 1 - left, 0);
+		int lastX = std::min( aRight + 1 - left, width - 1);
+		int firstY = std::max( aTop - 1 - top, 0);
+		int lastY = std::min( aBottom + 1 - top, height - 1);
+		for (int y = firstY; y <= lastY; ++y)
+		{
+			for (int x = firstX; x <= lastX; ++x)
+			{
+				updateCell( y * width + x);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void DStarLite::computeShortestPath()
+	{
+		std::size_t start = static_cast< std::size_t >( startCell);
+		while (!queue.empty() && (queue.front().key < calculateKey( startCell) || rhs[start] != g[start]))
+		{
+			std::int32_t cell = queue.front().cell;
+			std::size_t index = static_cast< std::size_t >( cell);
+			Key oldKey = queue.front().key;
+			Key newKey = calculateKey( cell);
+			countExpansion();
+
+			if (oldKey < newKey)
+			{
+				queueUpdate( cell, newKey);
+			} else if (g[index] > rhs[index])
+			{
+				// Overconsistent: the cell got cheaper, so may its predecessors
+				g[index] = rhs[index];
+				queueRemove( cell);
+				for (int direction = 0; direction < OccupancyGrid::DirectionCount; ++direction)
+				{
+					std::int32_t predecessor = neighbour( cell, direction);
+					if (predecessor != -1 && predecessor != goalCell)
+					{
+						// The move from the predecessor to cell is in the opposite direction
+						double viaCell = cost( cell, (direction + 4) % 8) + g[index];
+						if (viaCell < rhs[static_cast< std::size_t >( predecessor)])
+						{
+							rhs[static_cast< std::size_t >( predecessor)] = viaCell;
+							updateQueue( predecessor);
+						}
+					}
+				}
+			} else
+			{
+				// Underconsistent: the cell got more expensive, its predecessors that used it are recomputed
+				double oldG = g[index];
+				g[index] = Infinity;
+				updateQueue( cell);
+				for (int direction = 0; direction < OccupancyGrid::DirectionCount; ++direction)
+				{
+					std::int32_t predecessor = neighbour( cell, direction);
+					if (predecessor != -1 && rhs[static_cast< std::size_t >( predecessor)] == cost( cell, (direction + 4) % 8) + oldG)
+					{
+						updateCell( predecessor);
+					}
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	bool DStarLite::constructPath( Path& aPath) const
+	{
+		if (g[static_cast< std::size_t >( startCell)] == Infinity)
+		{
+			return false;
+		}
+
+		aPath.push_back( Vertex( left + startCell % width, top + startCell / width));
+		aPath.back().actualCost = 0.0;
+
+		// Every step goes to a cheaper cell, the number of cells bounds the loop if something went wrong
+		std::int32_t cell = startCell;
+		for (std::size_t steps = 0; cell != goalCell && steps < g.size(); ++steps)
+		{
+			std::int32_t next = -1;
+			double nextCost = Infinity;
+			double nextStep = 0.0;
+			for (int direction = 0; direction < OccupancyGrid::DirectionCount; ++direction)
+			{
+				std::int32_t successor = neighbour( cell, direction);
+				if (successor != -1)
+				{
+					double step = cost( successor, direction);
+					double viaSuccessor = step + g[static_cast< std::size_t >( successor)];
+					if (viaSuccessor < nextCost)
+					{
+						next = successor;
+						nextCost = viaSuccessor;
+						nextStep = step;
+					}
+				}
+			}
+			if (next == -1)
+			{
+				aPath.clear();
+				return false;
+			}
+
+			double actualCost = aPath.back().actualCost + nextStep;
+			aPath.push_back( Vertex( left + next % width, top + next / width));
+			aPath.back().actualCost = actualCost;
+			cell = next;
+		}
+
+		if (cell != goalCell)
+		{
+			aPath.clear();
+			return false;
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	void DStarLite::updateCell( std::int32_t aCell)
+	{
+		if (aCell != goalCell)
+		{
+			double minimum = Infinity;
+			for (int direction = 0; direction < OccupancyGrid::DirectionCount; ++direction)
+			{
+				std::int32_t successor = neighbour( aCell, direction);
+				if (successor != -1)
+				{
+					minimum = std::min( minimum, cost( successor, direction) + g[static_cast< std::size_t >( successor)]);
+				}
+			}
+			rhs[static_cast< std::size_t >( aCell)] = minimum;
+		}
+		updateQueue( aCell);
+	}
+	/**
+	 *
+	 */
+	void DStarLite::updateQueue( std::int32_t aCell)
+	{
+		std::size_t index = static_cast< std::size_t >( aCell);
+		bool queued = queuePositions[index] != -1;
+		if (g[index] != rhs[index])
+		{
+			if (queued)
+			{
+				queueUpdate( aCell, calculateKey( aCell));
+			} else
+			{
+				queuePush( aCell, calculateKey( aCell));
+			}
+		} else if (queued)
+		{
+			queueRemove( aCell);
+		}
+	}
+	/**
+	 *
+	 */
+	DStarLite::Key DStarLite::calculateKey( std::int32_t aCell) const
+	{
+		double minimum = std::min( g[static_cast< std::size_t >( aCell)], rhs[static_cast< std::size_t >( aCell)]);
+		return Key( minimum + heuristic( aCell) + keyModifier, minimum);
+	}
+	/**
+	 *
+	 */
+	bool DStarLite::isLineFree(	const Vertex& aFrom,
+								const Vertex& aTo) const
+	{
+		if (!AStar::isLineFree( aFrom, aTo))
+		{
+			return false;
+		}
+
+		// The distance from every other robot to the closest point of the line
+		double dx = aTo.x - aFrom.x;
+		double dy = aTo.y - aFrom.y;
+		double lengthSquared = dx * dx + dy * dy;
+		for (const wxPoint& position : robotObstacles)
+		{
+			double t = lengthSquared > 0.0 ? ((position.x - aFrom.x) * dx + (position.y - aFrom.y) * dy) / lengthSquared : 0.0;
+			t = std::max( 0.0, std::min( t, 1.0));
+			double closestX = aFrom.x + t * dx - position.x;
+			double closestY = aFrom.y + t * dy - position.y;
+			if (closestX * closestX + closestY * closestY <= freeRadius * freeRadius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	bool DStarLite::isBlocked( std::int32_t aCell) const
+	{
+		if (aCell == startCell)
+		{
+			return false;
+		}
+
+		int x = left + aCell % width;
+		int y = top + aCell / width;
+		countWallCheck();
+		if (getOccupancyGrid().isBlocked( x, y))
+		{
+			return true;
+		}
+		for (const wxPoint& position : robotObstacles)
+		{
+			int dx = x - position.x;
+			int dy = y - position.y;
+			if (dx * dx + dy * dy <= freeRadius * freeRadius)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	/**
+	 *
+	 */
+	double DStarLite::cost(	std::int32_t aTo,
+							int aDirection) const
+	{
+		return isBlocked( aTo) ? Infinity : OccupancyGrid::StepCost[aDirection];
+	}
+	/**
+	 *
+	 */
+	double DStarLite::heuristic( std::int32_t aCell) const
+	{
+		if (startCell == -1)
+		{
+			return 0.0;
+		}
+		int dx = (aCell % width) - (startCell % width);
+		int dy = (aCell / width) - (startCell / width);
+		return std::sqrt( dx * dx + dy * dy);
+	}
+	/**
+	 *
+	 */
+	std::int32_t DStarLite::neighbour(	std::int32_t aCell,
+										int aDirection) const
+	{
+		int x = aCell % width + OccupancyGrid::XOffset[aDirection];
+		int y = aCell / width + OccupancyGrid::YOffset[aDirection];
+		if (x < 0 || x >= width || y < 0 || y >= height)
+		{
+			return -1;
+		}
+		return y * width + x;
+	}
+	/**
+	 *
+	 */
+	std::int32_t DStarLite::cellIndex( const Vertex& aVertex) const
+	{
+		int column = aVertex.x - left;
+		int row = aVertex.y - top;
+		if (column < 0 || column >= width || row < 0 || row >= height)
+		{
+			return -1;
+		}
+		return row * width + column;
+	}
+	/**
+	 *
+	 */
+	void DStarLite::queuePush(	std::int32_t aCell,
+								const Key& aKey)
+	{
+		if (queue.size() == queue.capacity())
+		{
+			countAllocations( 1);
+		}
+		queue.push_back( QueueEntry{ aKey, aCell });
+		queuePositions[static_cast< std::size_t >( aCell)] = static_cast< std::int32_t >( queue.size() - 1);
+		siftUp( queue.size() - 1);
+		countOpenSetSize( queue.size());
+	}
+	/**
+	 *
+	 */
+	void DStarLite::queueRemove( std::int32_t aCell)
+	{
+		std::size_t position = static_cast< std::size_t >( queuePositions[static_cast< std::size_t >( aCell)]);
+		std::size_t last = queue.size() - 1;
+		if (position != last)
+		{
+			swapEntries( position, last);
+		}
+		queue.pop_back();
+		queuePositions[static_cast< std::size_t >( aCell)] = -1;
+		if (position < queue.size())
+		{
+			siftUp( position);
+			siftDown( position);
+		}
+	}
+	/**
+	 *
+	 */
+	void DStarLite::queueUpdate(	std::int32_t aCell,
+									const Key& aKey)
+	{
+		std::size_t position = static_cast< std::size_t >( queuePositions[static_cast< std::size_t >( aCell)]);
+		queue[position].key = aKey;
+		siftUp( position);
+		siftDown( position);
+	}
+	/**
+	 *
+	 */
+	void DStarLite::siftUp( std::size_t aPosition)
+	{
+		while (aPosition > 0)
+		{
+			std::size_t parent = (aPosition - 1) / 2;
+			if (!(queue[aPosition].key < queue[parent].key))
+			{
+				break;
+			}
+			swapEntries( aPosition, parent);
+			aPosition = parent;
+		}
+	}
+	/**
+	 *
+	 */
+	void DStarLite::siftDown( std::size_t aPosition)
+	{
+		for (;;)
+		{
+			std::size_t smallest = aPosition;
+			std::size_t leftChild = 2 * aPosition + 1;
+			std::size_t rightChild = leftChild + 1;
+			if (leftChild < queue.size() && queue[leftChild].key < queue[smallest].key)
+			{
+				smallest = leftChild;
+			}
+			if (rightChild < queue.size() && queue[rightChild].key < queue[smallest].key)
+			{
+				smallest = rightChild;
+			}
+			if (smallest == aPosition)
+			{
+				break;
+			}
+			swapEntries( aPosition, smallest);
+			aPosition = smallest;
+		}
+	}
+	/**
+	 *
+	 */
+	void DStarLite::swapEntries(	std::size_t aPosition,
+									std::size_t anOtherPosition)
+	{
+		std::swap( queue[aPosition], queue[anOtherPosition]);
+		queuePositions[static_cast< std::size_t >( queue[aPosition].cell)] = static_cast< std::int32_t >( aPosition);
+		queuePositions[static_cast< std::size_t >( queue[anOtherPosition].cell)] = static_cast< std::int32_t >( anOtherPosition);
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,178 @@
+#ifndef DSTARLITE_HPP_
+#define DSTARLITE_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * D* Lite (Koenig and Likhachev, 2002) searches backwards from the goal and keeps its search state
+	 * between searches. As long as the goal and the size of the robot stay the same, a next search only
+	 * repairs the cells around the walls that changed and around the other robots that moved, and the
+	 * start may move along the path. Replanning while driving costs a fraction of a full search.
+	 *
+	 * The other robots are obstacles: a robot does not plan through a circle with its own free radius
+	 * around the position of another robot, just like a wall is inflated with that radius. The cell of the
+	 * start itself is never blocked so a robot can always drive away from another robot.
+	 *
+	 * The moves are the same as those of AStar. If the start or the goal is outside the OccupancyGrid
+	 * or if there is no path the search falls back to AStar, which ignores the other robots.
+	 */
+	class DStarLite : public AStar
+	{
+		public:
+			/**
+			 *
+			 */
+			DStarLite();
+			/**
+			 *
+			 */
+			using AStar::search;
+			/**
+			 *
+			 */
+			virtual void search(Vertex aStart,
+								const Vertex& aGoal,
+								const wxSize& aRobotSize,
+								Path& aPath) override;
+			/**
+			 * Sets the positions of the other robots for the next search
+			 */
+			void setRobotObstacles( const std::vector< wxPoint >& aPositions);
+
+		protected:
+			/**
+			 * A straight line must stay clear of the other robots as well
+			 */
+			virtual bool isLineFree(	const Vertex& aFrom,
+										const Vertex& aTo) const override;
+
+		private:
+			/**
+			 * The priority of a cell in the queue, compared lexicographically
+			 */
+			typedef std::pair< double, double > Key;
+			/**
+			 *
+			 */
+			struct QueueEntry
+			{
+				Key key;
+				std::int32_t cell;
+			};
+			/**
+			 * Starts from scratch for aGoal with the current bounds of the OccupancyGrid
+			 */
+			void reset( const Vertex& aGoal);
+			/**
+			 * Updates the cells whose costs may have changed because of the walls or the other robots
+			 */
+			void processChanges();
+			/**
+			 * Updates all cells in the area, the costs to the cells in it may have changed
+			 */
+			void updateArea(	int aLeft,
+								int aTop,
+								int aRight,
+								int aBottom);
+			/**
+			 *
+			 */
+			void computeShortestPath();
+			/**
+			 * Writes the path from the start into aPath by following the cheapest successors
+			 */
+			bool constructPath( Path& aPath) const;
+			/**
+			 * Recomputes the rhs of aCell and puts it in or takes it out of the queue
+			 */
+			void updateCell( std::int32_t aCell);
+			/**
+			 * Puts the cell in, moves it in or takes it out of the queue depending on its consistency
+			 */
+			void updateQueue( std::int32_t aCell);
+			/**
+			 *
+			 */
+			Key calculateKey( std::int32_t aCell) const;
+			/**
+			 *
+			 * @return true if a robot can not be at the cell, the start cell is never blocked
+			 */
+			bool isBlocked( std::int32_t aCell) const;
+			/**
+			 *
+			 * @return the cost of the move in direction aDirection into the cell aTo
+			 */
+			double cost(	std::int32_t aTo,
+							int aDirection) const;
+			/**
+			 *
+			 */
+			double heuristic( std::int32_t aCell) const;
+			/**
+			 *
+			 * @return the neighbour of aCell in direction aDirection or -1 if it is outside the grid
+			 */
+			std::int32_t neighbour(	std::int32_t aCell,
+									int aDirection) const;
+			/**
+			 *
+			 */
+			std::int32_t cellIndex( const Vertex& aVertex) const;
+			/**
+			 * The queue, an indexed binary min-heap
+			 */
+			void queuePush(	std::int32_t aCell,
+							const Key& aKey);
+			void queueRemove( std::int32_t aCell);
+			void queueUpdate(	std::int32_t aCell,
+								const Key& aKey);
+			void siftUp( std::size_t aPosition);
+			void siftDown( std::size_t aPosition);
+			void swapEntries(	std::size_t aPosition,
+								std::size_t anOtherPosition);
+
+			bool valid;
+			/**
+			 * The bounds of the OccupancyGrid the search state belongs to
+			 */
+			int left;
+			int top;
+			int width;
+			int height;
+			unsigned long rebuildCount;
+			unsigned long geometryVersion;
+			int freeRadius;
+			/**
+			 *
+			 */
+			std::int32_t goalCell;
+			std::int32_t startCell;
+			std::int32_t lastStartCell;
+			double keyModifier;
+			/**
+			 * The cost-to-goal and the one-step lookahead cost-to-goal of every cell
+			 */
+			std::vector< double > g;
+			std::vector< double > rhs;
+			/**
+			 * The position of every cell in the queue or -1
+			 */
+			std::vector< std::int32_t > queuePositions;
+			std::vector< QueueEntry > queue;
+			/**
+			 * The other robots as they were searched around and as they are now
+			 */
+			std::vector< wxPoint > robotObstacles;
+			std::vector< wxPoint > newRobotObstacles;
+	}; // class DStarLite
+} // namespace PathAlgorithm
+#endif // DSTARLITE_HPP_
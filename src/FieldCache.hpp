@@ -0,0 +1,66 @@
+#ifndef FIELDCACHE_HPP_
+#define FIELDCACHE_HPP_
+
+#include "Config.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * The last Capacity fields that were built for the walls as they are now. A field of an older geometry
+	 * version will never be used again and is dropped, if the cache is full the oldest field is dropped.
+	 * FieldType needs getGeometryVersion().
+	 */
+	template< typename FieldType, std::size_t Capacity = 16 >
+	class FieldCache
+	{
+		public:
+			typedef std::shared_ptr< const FieldType > FieldPtr;
+			/**
+			 * @return the field for which aMatch returns true, made by aBuild if there is none for aGeometryVersion
+			 */
+			template< typename MatchFunction, typename BuildFunction >
+			FieldPtr get(	unsigned long aGeometryVersion,
+							MatchFunction aMatch,
+							BuildFunction aBuild)
+			{
+				std::lock_guard< std::mutex > lock( fieldsMutex);
+
+				fields.erase( std::remove_if( fields.begin(), fields.end(), [aGeometryVersion]( const FieldPtr& aField)
+											  {
+												  return aField->getGeometryVersion() != aGeometryVersion;
+											  }),
+							  fields.end());
+
+				auto i = std::find_if( fields.begin(), fields.end(), aMatch);
+				if (i != fields.end())
+				{
+					return *i;
+				}
+
+				FieldPtr field = aBuild();
+				if (fields.size() == Capacity)
+				{
+					fields.erase( fields.begin());
+				}
+				fields.push_back( field);
+				return field;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			std::mutex fieldsMutex;
+			/**
+			 * Oldest first
+			 */
+			std::vector< FieldPtr > fields;
+	}; // class FieldCache
+} // namespace PathAlgorithm
+#endif // FIELDCACHE_HPP_
@@ -0,0 +1,98 @@
+#include "FlowField.hpp"
+
+#include "FieldCache.hpp"
+
+#include <limits>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	/* static */ FlowFieldPtr FlowField::getFlowField(	const wxPoint& aGoal,
+														const wxSize& aRobotSize)
+	{
+		static FieldCache< FlowField > flowFields;
+
+		// The CostField is only rebuilt if the walls changed, so is this field
+		CostFieldPtr costField = CostField::getCostField( aGoal, aRobotSize);
+
+		return flowFields.get(	costField->getGeometryVersion(),
+								[&costField]( const FlowFieldPtr& aFlowField)
+								{
+									return aFlowField->getCostField() == costField;
+								},
+								[&costField]()
+								{
+									return std::make_shared< const FlowField >( costField);
+								});
+	}
+	/**
+	 *
+	 */
+	FlowField::FlowField( const CostFieldPtr& aCostField) :
+		costField( aCostField),
+		directions( static_cast< std::size_t >( aCostField->getWidth()) * static_cast< std::size_t >( aCostField->getHeight()), NoDirection)
+	{
+		// The direction of a cell is the neighbour through which its route is cheapest, as in CostField::getPath()
+		std::size_t cell = 0;
+		for (int y = costField->getTop(); y < costField->getTop() + costField->getHeight(); ++y)
+		{
+			for (int x = costField->getLeft(); x < costField->getLeft() + costField->getWidth(); ++x, ++cell)
+			{
+				double cost = costField->getCost( x, y);
+				if (cost == std::numeric_limits< double >::infinity())
+				{
+					continue;
+				}
+				// Only a cheaper neighbour is a step towards the goal, so following the directions always ends there
+				double best = std::numeric_limits< double >::infinity();
+				for (int i = 0; i < OccupancyGrid::DirectionCount; ++i)
+				{
+					double neighbourCost = costField->getCost( x + OccupancyGrid::XOffset[i], y + OccupancyGrid::YOffset[i]);
+					double viaNeighbour = neighbourCost + OccupancyGrid::StepCost[i];
+					if (neighbourCost < cost && viaNeighbour < best)
+					{
+						best = viaNeighbour;
+						directions[cell] = static_cast< std::int8_t >( i);
+					}
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	std::int8_t FlowField::getDirection(	int anX,
+											int anY) const
+	{
+		int column = anX - costField->getLeft();
+		int row = anY - costField->getTop();
+		if (column < 0 || column >= costField->getWidth() || row < 0 || row >= costField->getHeight())
+		{
+			return NoDirection;
+		}
+		return directions[static_cast< std::size_t >( row) * static_cast< std::size_t >( costField->getWidth()) + static_cast< std::size_t >( column)];
+	}
+	/**
+	 *
+	 */
+	wxPoint FlowField::advance(	const wxPoint& aPosition,
+								double aDistance) const
+	{
+		wxPoint position = aPosition;
+		double travelled = 0.0;
+		while (travelled < aDistance)
+		{
+			std::int8_t direction = getDirection( position.x, position.y);
+			if (direction == NoDirection)
+			{
+				break;
+			}
+			position.x += OccupancyGrid::XOffset[direction];
+			position.y += OccupancyGrid::YOffset[direction];
+			travelled += OccupancyGrid::StepCost[direction];
+		}
+		return position;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,81 @@
+#ifndef FLOWFIELD_HPP_
+#define FLOWFIELD_HPP_
+
+#include "Config.hpp"
+
+#include "CostField.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	class FlowField;
+	typedef std::shared_ptr< const FlowField > FlowFieldPtr;
+
+	/**
+	 * A FlowField gives every cell the direction of the first step of the shortest route to a goal, derived
+	 * once from the CostField (the integration field) of that goal. A robot does not plan a route: every step
+	 * it reads the direction of the cell it is in, so the cost per robot per step does not depend on the
+	 * size of the world or on the number of robots that share the field.
+	 */
+	class FlowField
+	{
+		public:
+			/**
+			 * No direction: the goal itself, a blocked cell or a cell without a route
+			 */
+			static constexpr std::int8_t NoDirection = -1;
+			/**
+			 * @return the field to aGoal for a robot of aRobotSize and the walls as they are now
+			 */
+			static FlowFieldPtr getFlowField(	const wxPoint& aGoal,
+												const wxSize& aRobotSize);
+			/**
+			 *
+			 */
+			explicit FlowField( const CostFieldPtr& aCostField);
+			/**
+			 *
+			 * @return the direction at (anX,anY) as an index in the directions of OccupancyGrid or NoDirection
+			 */
+			std::int8_t getDirection(	int anX,
+										int anY) const;
+			/**
+			 * Follows the directions from aPosition for about aDistance
+			 *
+			 * @return the position reached, aPosition itself if there is no direction there
+			 */
+			wxPoint advance(	const wxPoint& aPosition,
+								double aDistance) const;
+			/**
+			 *
+			 */
+			wxPoint getGoal() const
+			{
+				return costField->getGoal();
+			}
+			/**
+			 *
+			 */
+			unsigned long getGeometryVersion() const
+			{
+				return costField->getGeometryVersion();
+			}
+			/**
+			 *
+			 */
+			const CostFieldPtr& getCostField() const
+			{
+				return costField;
+			}
+
+		private:
+			CostFieldPtr costField;
+			std::vector< std::int8_t > directions;
+	}; // class FlowField
+} // namespace PathAlgorithm
+#endif // FLOWFIELD_HPP_
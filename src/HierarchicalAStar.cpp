@@ -0,0 +1,54 @@
+#include "HierarchicalAStar.hpp"
+
+#include <cmath>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	HierarchicalAStar::HierarchicalAStar()
+	{
+	}
+	/**
+	 *
+	 */
+	void HierarchicalAStar::search(	Vertex aStart,
+									const Vertex& aGoal,
+									const wxSize& aRobotSize,
+									Path& aPath)
+	{
+		getOS().clear();
+		resetSearchStats();
+
+		synchroniseOccupancyGrid( aRobotSize);
+		clusterGraph.update( getOccupancyGrid());
+
+		if (clusterGraph.findPath( aStart, aGoal, aPath))
+		{
+			// Nothing was searched on the grid, the closed set and the predecessors of a previous search are gone
+			getGrid().reset( 0, 0, 0, 0);
+
+			aPath.front().actualCost = 0.0;
+			for (std::size_t i = 1; i < aPath.size(); ++i)
+			{
+				int dx = aPath[i].x - aPath[i - 1].x;
+				int dy = aPath[i].y - aPath[i - 1].y;
+				aPath[i].actualCost = aPath[i - 1].actualCost + std::sqrt( dx * dx + dy * dy);
+			}
+			notifyProgress( true);
+			return;
+		}
+
+		// AStar also finds its way out of a start inside an (inflated) wall and through the diagonals
+		// between clusters
+		AStar::search( aStart, aGoal, aRobotSize, aPath);
+	}
+	/**
+	 *
+	 */
+	const ClusterGraph& HierarchicalAStar::getClusterGraph() const
+	{
+		return clusterGraph;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,50 @@
+#ifndef HIERARCHICALASTAR_HPP_
+#define HIERARCHICALASTAR_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+#include "ClusterGraph.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * HierarchicalAStar plans on the ClusterGraph of the OccupancyGrid and refines the abstract path only
+	 * inside the clusters that it crosses. The graph is kept between searches and only the clusters that
+	 * are touched by changed walls are rebuilt.
+	 *
+	 * The path is a few percent longer than the one of AStar. If the start or the goal is not in a free
+	 * cell of the graph, or if the graph has no path, the search falls back to AStar: the graph only has
+	 * straight transitions and misses a diagonal squeeze through the corner of a cluster.
+	 */
+	class HierarchicalAStar : public AStar
+	{
+		public:
+			/**
+			 *
+			 */
+			HierarchicalAStar();
+			/**
+			 *
+			 */
+			using AStar::search;
+			/**
+			 *
+			 */
+			virtual void search(Vertex aStart,
+								const Vertex& aGoal,
+								const wxSize& aRobotSize,
+								Path& aPath) override;
+			/**
+			 *
+			 */
+			const ClusterGraph& getClusterGraph() const;
+
+		private:
+			/**
+			 *
+			 */
+			ClusterGraph clusterGraph;
+	}; // class HierarchicalAStar
+} // namespace PathAlgorithm
+#endif // HIERARCHICALASTAR_HPP_
@@ -0,0 +1,150 @@
+#include "JumpPointSearch.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	void JumpPointSearch::getSuccessors(	const Vertex& aCurrent,
+											std::int32_t aCurrentCell,
+											const Vertex& aGoal,
+											std::vector< Vertex >& aSuccessors) const
+	{
+		int x = aCurrent.x;
+		int y = aCurrent.y;
+
+		// At most 5 directions survive the pruning, 8 for the start Vertex
+		int directions[8][2];
+		int numberOfDirections = 0;
+
+		std::int32_t predecessor = getGrid().getPredecessor( aCurrentCell);
+		if (predecessor == SearchGrid::NoCell)
+		{
+			for (int i = 0; i < OccupancyGrid::DirectionCount; ++i)
+			{
+				directions[numberOfDirections][0] = OccupancyGrid::XOffset[i];
+				directions[numberOfDirections][1] = OccupancyGrid::YOffset[i];
+				++numberOfDirections;
+			}
+		} else
+		{
+			int px = getGrid().cellX( predecessor);
+			int py = getGrid().cellY( predecessor);
+			int dx = (x > px) - (x < px);
+			int dy = (y > py) - (y < py);
+
+			auto addDirection = [&directions, &numberOfDirections]( int aDx, int aDy)
+			{
+				directions[numberOfDirections][0] = aDx;
+				directions[numberOfDirections][1] = aDy;
+				++numberOfDirections;
+			};
+
+			if (dx != 0 && dy != 0)
+			{
+				// The natural neighbours
+				addDirection( 0, dy);
+				addDirection( dx, 0);
+				addDirection( dx, dy);
+				// The forced neighbours
+				if (isBlocked( x - dx, y))
+				{
+					addDirection( -dx, dy);
+				}
+				if (isBlocked( x, y - dy))
+				{
+					addDirection( dx, -dy);
+				}
+			} else if (dx != 0)
+			{
+				addDirection( dx, 0);
+				if (isBlocked( x, y + 1))
+				{
+					addDirection( dx, 1);
+				}
+				if (isBlocked( x, y - 1))
+				{
+					addDirection( dx, -1);
+				}
+			} else
+			{
+				addDirection( 0, dy);
+				if (isBlocked( x + 1, y))
+				{
+					addDirection( 1, dy);
+				}
+				if (isBlocked( x - 1, y))
+				{
+					addDirection( -1, dy);
+				}
+			}
+		}
+
+		for (int i = 0; i < numberOfDirections; ++i)
+		{
+			Vertex jumpPoint( 0, 0);
+			if (jump( x, y, directions[i][0], directions[i][1], aGoal, jumpPoint))
+			{
+				aSuccessors.push_back( jumpPoint);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	bool JumpPointSearch::isBlocked(	int anX,
+										int anY) const
+	{
+		countWallCheck();
+		return getGrid().cellIndex( anX, anY) == SearchGrid::NoCell || getOccupancyGrid().isBlocked( anX, anY);
+	}
+	/**
+	 *
+	 */
+	bool JumpPointSearch::jump(	int anX,
+								int anY,
+								int aDx,
+								int aDy,
+								const Vertex& aGoal,
+								Vertex& aJumpPoint) const
+	{
+		// The grid is bounded, so is this loop: outside the grid everything is blocked
+		for (;;)
+		{
+			anX += aDx;
+			anY += aDy;
+
+			if (isBlocked( anX, anY))
+			{
+				return false;
+			}
+
+			bool isJumpPoint = false;
+			if (anX == aGoal.x && anY == aGoal.y)
+			{
+				isJumpPoint = true;
+			} else if (aDx != 0 && aDy != 0)
+			{
+				Vertex straightJumpPoint( 0, 0);
+				isJumpPoint = (!isBlocked( anX - aDx, anY + aDy) && isBlocked( anX - aDx, anY)) ||
+							  (!isBlocked( anX + aDx, anY - aDy) && isBlocked( anX, anY - aDy)) ||
+							  jump( anX, anY, aDx, 0, aGoal, straightJumpPoint) ||
+							  jump( anX, anY, 0, aDy, aGoal, straightJumpPoint);
+			} else if (aDx != 0)
+			{
+				isJumpPoint = (!isBlocked( anX + aDx, anY + 1) && isBlocked( anX, anY + 1)) ||
+							  (!isBlocked( anX + aDx, anY - 1) && isBlocked( anX, anY - 1));
+			} else
+			{
+				isJumpPoint = (!isBlocked( anX + 1, anY + aDy) && isBlocked( anX + 1, anY)) ||
+							  (!isBlocked( anX - 1, anY + aDy) && isBlocked( anX - 1, anY));
+			}
+
+			if (isJumpPoint)
+			{
+				aJumpPoint = Vertex( anX, anY);
+				return true;
+			}
+		}
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,49 @@
+#ifndef JUMPPOINTSEARCH_HPP_
+#define JUMPPOINTSEARCH_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Jump Point Search (Harabor and Grastien, 2011) is an AStar for uniform-cost grids that prunes the
+	 * symmetric paths: instead of all neighbours only the jump points, i.e. the cells with forced neighbours,
+	 * are added to the openSet. The result is an optimal path with the same clearance as the AStar, but with
+	 * far fewer expanded Vertices in open fields.
+	 *
+	 * The path that is returned contains every cell, just like the one of AStar.
+	 */
+	class JumpPointSearch : public AStar
+	{
+		protected:
+			/**
+			 * Appends the jump points that can be reached from aCurrent
+			 */
+			virtual void getSuccessors(	const Vertex& aCurrent,
+										std::int32_t aCurrentCell,
+										const Vertex& aGoal,
+										std::vector< Vertex >& aSuccessors) const override;
+
+		private:
+			/**
+			 *
+			 * @return true if the robot does not fit at (anX,anY) or if the point is outside the grid
+			 */
+			bool isBlocked(	int anX,
+							int anY) const;
+			/**
+			 * Walks from (anX,anY) in the direction (aDx,aDy) until a jump point is found
+			 *
+			 * @return true if a jump point is found, aJumpPoint is then set
+			 */
+			bool jump(	int anX,
+						int anY,
+						int aDx,
+						int aDy,
+						const Vertex& aGoal,
+						Vertex& aJumpPoint) const;
+	}; // class JumpPointSearch
+} // namespace PathAlgorithm
+#endif // JUMPPOINTSEARCH_HPP_
@@ -2,10 +2,12 @@
 
 #include "MainFrameWindow.hpp"
 #include "ObjectId.hpp"
+#include "PlannerBenchmark.hpp"
 
 #include <stdexcept>
 #include <algorithm>
 #include <cstring>
+#include <iostream>
 
 
 namespace Application
@@ -38,6 +40,14 @@ namespace Application
 
 		MainApplication::setCommandlineArguments( argc, argv);
 
+		// Only compare the path planners, there is no window
+		if(MainApplication::isArgGiven("-benchmark"))
+		{
+			bool json = MainApplication::getArg("-benchmark").value == "json";
+			PlannerBenchmark::run( std::cout, 3, json ? PlannerBenchmark::JsonFormat : PlannerBenchmark::TableFormat);
+			return false;
+		}
+
 		MainFrameWindow* frame = nullptr;
 		if(MainApplication::isArgGiven("-worldname"))
 		{
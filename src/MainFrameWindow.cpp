@@ -57,6 +57,7 @@ namespace Application
 																drawOpenSetCheckbox(nullptr),
 																speedSpinCtrl(nullptr),
 																worldNumber(nullptr),
+																pathPlanner(nullptr),
 																buttonPanel( nullptr)
 	{
 		initialise();
@@ -439,6 +440,15 @@ namespace Application
 					wxGBPosition( 3, 1),
 					wxGBSpan( 1, 1),
 					wxSHRINK | wxALIGN_CENTER);
+
+		sizer->Add(	pathPlanner = makeRadiobox(	panel,
+												std::array< std::string, 7 >{ "A*", "Jump Point Search", "Hierarchical A*", "D* Lite", "Nearest goal", "Flow field", "Cooperative A*" },
+												[this](wxCommandEvent& event){this->OnPathPlanner(event);},
+												"Path planner",
+												wxSHRINK | wxALIGN_CENTER),
+					wxGBPosition( 3, 2),
+					wxGBSpan( 1, 1),
+					wxSHRINK | wxALIGN_CENTER);
 		sizer->AddGrowableRow( 3);
 		sizer->AddGrowableCol( 1);
 
@@ -454,6 +464,7 @@ namespace Application
 		drawOpenSetCheckbox->SetValue(mainSettings.getDrawOpenSet());
 		speedSpinCtrl->SetValue(static_cast<int>(mainSettings.getSpeed()));
 		worldNumber->SetSelection(static_cast<int>(mainSettings.getWorldNumber()));
+		pathPlanner->SetSelection(static_cast<int>(mainSettings.getPathPlanner()));
 
 		if(MainApplication::isArgGiven("-debug_grid"))
 		{
@@ -645,6 +656,16 @@ namespace Application
 		MainSettings& mainSettings = MainApplication::getSettings();
 		mainSettings.setWorldNumber(worldNumber->GetSelection());
 	}
+	/**
+	 *
+	 */
+	void MainFrameWindow::OnPathPlanner( wxCommandEvent& anEvent)
+	{
+		TRACE_DEVELOP(anEvent.GetString().ToStdString());
+
+		MainSettings& mainSettings = MainApplication::getSettings();
+		mainSettings.setPathPlanner(static_cast<MainSettings::PathPlanner>(pathPlanner->GetSelection()));
+	}
 	/**
 	 *
 	 */
@@ -653,36 +674,28 @@ namespace Application
 	 */
 	void MainFrameWindow::OnStartRobot( wxCommandEvent& UNUSEDPARAM(anEvent))
 	{
-		/*
+		// All robots start at once, their searches share the PlanningPool
 		for(Model::RobotPtr robot : Model::RobotWorld::getRobotWorld().getRobots())
 		{
 			if (robot && !robot->isActing())
-			{	
-				robot->getGoalName();
-
+			{
 				robot->startActing();
 			}else{
 				TRACE_DEVELOP("Robot is already acting");
 			}
 		}
-		*/
-
-
-		Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot("Robot");
-		if (robot && !robot->isActing())
-		{
-			robot->startActing();
-		}
 	}
 	/**
 	 *
 	 */
 	void MainFrameWindow::OnStopRobot( wxCommandEvent& UNUSEDPARAM(anEvent))
 	{
-		Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot( "Robot");
-		if (robot && robot->isActing())
+		for(Model::RobotPtr robot : Model::RobotWorld::getRobotWorld().getRobots())
 		{
-			robot->stopActing();
+			if (robot && robot->isActing())
+			{
+				robot->stopActing();
+			}
 		}
 	}
 	/**
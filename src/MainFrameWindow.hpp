@@ -92,6 +92,7 @@ namespace Application
 			wxCheckBox* drawOpenSetCheckbox;
 			wxSpinCtrl* speedSpinCtrl;
 			wxRadioBox* worldNumber;
+			wxRadioBox* pathPlanner;
 
 			wxPanel* buttonPanel;
 
@@ -104,6 +105,7 @@ namespace Application
 			void OnDrawOpenSet( wxCommandEvent& anEvent);
 			void OnSpeedSpinCtrlUpdate( wxCommandEvent& anEvent);
             void OnWorld(wxCommandEvent &anEvent);
+			void OnPathPlanner( wxCommandEvent& anEvent);
 
 			void OnStartRobot( wxCommandEvent& anEvent);
 			void OnStopRobot( wxCommandEvent& anEvent);
@@ -5,7 +5,7 @@ namespace Application
 	/**
 	 *
 	 */
-	MainSettings::MainSettings() : drawOpenSet(true), speed(5), worldNumber(0)
+	MainSettings::MainSettings() : drawOpenSet(true), speed(5), worldNumber(0), pathPlanner(AStarPlanner)
 	{
 	}
 	/**
@@ -56,4 +56,18 @@ namespace Application
 	{
 		worldNumber = aWorldNumber;
 	}
+	/**
+	 *
+	 */
+	MainSettings::PathPlanner MainSettings::getPathPlanner() const
+	{
+		return pathPlanner;
+	}
+	/**
+	 *
+	 */
+	void MainSettings::setPathPlanner( PathPlanner aPathPlanner)
+	{
+		pathPlanner = aPathPlanner;
+	}
 } /* namespace Application */
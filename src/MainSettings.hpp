@@ -12,6 +12,19 @@ namespace Application
 	class MainSettings
 	{
 		public:
+			/**
+			 * The path planners a robot can use
+			 */
+			enum PathPlanner
+			{
+				AStarPlanner,
+				JumpPointSearchPlanner,
+				HierarchicalPlanner,
+				DStarLitePlanner,
+				NearestGoalPlanner,
+				FlowFieldPlanner,
+				CooperativePlanner
+			};
 			/**
 			 *
 			 */
@@ -44,11 +57,20 @@ namespace Application
 			 *
 			 */
 			void setWorldNumber( unsigned long aWorldNumber);
+			/**
+			 *
+			 */
+			PathPlanner getPathPlanner() const;
+			/**
+			 *
+			 */
+			void setPathPlanner( PathPlanner aPathPlanner);
 
 		private:
 			bool drawOpenSet;
 			unsigned long speed;
 			unsigned long worldNumber;
+			PathPlanner pathPlanner;
 	};
 
 } /* namespace Application */
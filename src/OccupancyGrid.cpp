@@ -0,0 +1,252 @@
+#include "OccupancyGrid.hpp"
+
+#include "Shape2DUtils.hpp"
+#include "Wall.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	OccupancyGrid::OccupancyGrid() :
+		left( 0),
+		top( 0),
+		width( 0),
+		height( 0),
+		freeRadius( 0),
+		geometryVersion( 0),
+		changedSinceVersion( 0),
+		rebuildCount( 0),
+		valid( false)
+	{
+	}
+	/**
+	 *
+	 */
+	std::uint8_t OccupancyGrid::getFreeNeighbours(	int anX,
+													int anY) const
+	{
+		int column = anX - left;
+		int row = anY - top;
+		if (column < 1 || column >= width - 1 || row < 1 || row >= height - 1)
+		{
+			// At or beyond the border some neighbours are outside the grid, those are free
+			std::uint8_t mask = 0;
+			for (int i = 0; i < DirectionCount; ++i)
+			{
+				if (!isBlocked( anX + XOffset[i], anY + YOffset[i]))
+				{
+					mask = static_cast< std::uint8_t >( mask | (1U << i));
+				}
+			}
+			return mask;
+		}
+
+		unsigned int above = getThreeCells( column - 1, row - 1);
+		unsigned int middle = getThreeCells( column - 1, row);
+		unsigned int below = getThreeCells( column - 1, row + 1);
+
+		// Scatter the blocked bits of the rows to the directions
+		unsigned int blockedMask = ((below >> 1) & 1U) |
+								   ((below >> 2) & 1U) << 1 |
+								   ((middle >> 2) & 1U) << 2 |
+								   ((above >> 2) & 1U) << 3 |
+								   ((above >> 1) & 1U) << 4 |
+								   (above & 1U) << 5 |
+								   (middle & 1U) << 6 |
+								   (below & 1U) << 7;
+		return static_cast< std::uint8_t >( ~blockedMask & 0xFFU);
+	}
+	/**
+	 *
+	 */
+	bool OccupancyGrid::isLineFree(	int aFromX,
+									int aFromY,
+									int aToX,
+									int aToY) const
+	{
+		int dx = std::abs( aToX - aFromX);
+		int dy = std::abs( aToY - aFromY);
+		int stepX = aToX > aFromX ? 1 : -1;
+		int stepY = aToY > aFromY ? 1 : -1;
+
+		// The error tells which side of the line the corner of the next two cells is
+		int x = aFromX;
+		int y = aFromY;
+		int error = dx - dy;
+		for (int n = dx + dy; n >= 0; --n)
+		{
+			if (isBlocked( x, y))
+			{
+				return false;
+			}
+			if (error > 0)
+			{
+				x += stepX;
+				error -= 2 * dy;
+			} else if (error < 0)
+			{
+				y += stepY;
+				error += 2 * dx;
+			} else
+			{
+				// Exactly through the corner: a robot must fit on both sides of it
+				if (n > 0 && (isBlocked( x + stepX, y) || isBlocked( x, y + stepY)))
+				{
+					return false;
+				}
+				x += stepX;
+				y += stepY;
+				error += 2 * (dx - dy);
+				--n;
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::synchronise(	const std::vector< Model::WallPtr >& aWalls,
+										int aFreeRadius,
+										unsigned long aGeometryVersion)
+	{
+		if (valid && aFreeRadius == freeRadius && aGeometryVersion == geometryVersion)
+		{
+			return;
+		}
+
+		changedSinceVersion = geometryVersion;
+		geometryVersion = aGeometryVersion;
+		changedAreas.clear();
+
+		if (!valid || aFreeRadius != freeRadius)
+		{
+			freeRadius = aFreeRadius;
+			rebuild( aWalls);
+			return;
+		}
+
+		// Find the walls that were added or moved
+		std::unordered_map< const Model::Wall*, Segment > current;
+		for (const Model::WallPtr& wall : aWalls)
+		{
+			Segment segment( wall->getPoint1(), wall->getPoint2());
+			if (!fits( segment))
+			{
+				rebuild( aWalls);
+				return;
+			}
+			current.emplace( wall.get(), segment);
+		}
+
+		// Remove the walls that were deleted or moved
+		for (auto i = segments.begin(); i != segments.end();)
+		{
+			auto c = current.find( i->first);
+			if (c == current.end() || c->second != i->second)
+			{
+				rasterize( i->second, -1);
+				i = segments.erase( i);
+			} else
+			{
+				++i;
+			}
+		}
+		// And add the walls that were added or moved
+		for (const auto& [wall, segment] : current)
+		{
+			if (segments.find( wall) == segments.end())
+			{
+				rasterize( segment, 1);
+				segments.emplace( wall, segment);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::rebuild( const std::vector< Model::WallPtr >& aWalls)
+	{
+		int right = 0;
+		int bottom = 0;
+		left = 0;
+		top = 0;
+		for (const Model::WallPtr& wall : aWalls)
+		{
+			left = std::min( { left, wall->getPoint1().x, wall->getPoint2().x });
+			top = std::min( { top, wall->getPoint1().y, wall->getPoint2().y });
+			right = std::max( { right, wall->getPoint1().x, wall->getPoint2().x });
+			bottom = std::max( { bottom, wall->getPoint1().y, wall->getPoint2().y });
+		}
+		left -= freeRadius + 1;
+		top -= freeRadius + 1;
+		width = right - left + freeRadius + 2;
+		height = bottom - top + freeRadius + 2;
+
+		std::size_t cellCount = static_cast< std::size_t >( width) * static_cast< std::size_t >( height);
+		counts.assign( cellCount, 0);
+		blocked.assign( (cellCount + 63) / 64, 0);
+		segments.clear();
+
+		for (const Model::WallPtr& wall : aWalls)
+		{
+			Segment segment( wall->getPoint1(), wall->getPoint2());
+			rasterize( segment, 1);
+			segments.emplace( wall.get(), segment);
+		}
+		// Everything changed
+		changedAreas.clear();
+		++rebuildCount;
+		valid = true;
+	}
+	/**
+	 *
+	 */
+	bool OccupancyGrid::fits( const Segment& aSegment) const
+	{
+		return std::min( aSegment.first.x, aSegment.second.x) - freeRadius >= left &&
+			   std::min( aSegment.first.y, aSegment.second.y) - freeRadius >= top &&
+			   std::max( aSegment.first.x, aSegment.second.x) + freeRadius < left + width &&
+			   std::max( aSegment.first.y, aSegment.second.y) + freeRadius < top + height;
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::rasterize(	const Segment& aSegment,
+									int aDelta)
+	{
+		int xMin = std::min( aSegment.first.x, aSegment.second.x) - freeRadius;
+		int xMax = std::max( aSegment.first.x, aSegment.second.x) + freeRadius;
+		int yMin = std::min( aSegment.first.y, aSegment.second.y) - freeRadius;
+		int yMax = std::max( aSegment.first.y, aSegment.second.y) + freeRadius;
+
+		changedAreas.push_back( Area{ xMin, yMin, xMax, yMax });
+
+		for (int y = yMin; y <= yMax; ++y)
+		{
+			for (int x = xMin; x <= xMax; ++x)
+			{
+				// Exactly the same test as the search did for every wall for every neighbour
+				if (!Utils::Shape2DUtils::isOnLine( aSegment.first, aSegment.second, wxPoint( x, y), freeRadius))
+				{
+					continue;
+				}
+
+				std::size_t cell = static_cast< std::size_t >( (y - top) * width + (x - left));
+				counts[cell] = static_cast< std::uint16_t >( counts[cell] + aDelta);
+
+				std::uint64_t mask = std::uint64_t( 1) << (cell & 63);
+				if (counts[cell] != 0)
+				{
+					blocked[cell >> 6] |= mask;
+				} else
+				{
+					blocked[cell >> 6] &= ~mask;
+				}
+			}
+		}
+	}
+} // namespace PathAlgorithm
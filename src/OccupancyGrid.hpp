@@ -0,0 +1,222 @@
+#ifndef OCCUPANCYGRID_HPP_
+#define OCCUPANCYGRID_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Model
+{
+	class Wall;
+	typedef std::shared_ptr< Wall > WallPtr;
+}
+
+namespace PathAlgorithm
+{
+	/**
+	 * The OccupancyGrid is the configuration space of a robot: every wall is rasterized and inflated with
+	 * the free radius of the robot, so checking whether the robot fits at a point is a single bit lookup.
+	 *
+	 * Every cell counts the walls that block it. This allows for incremental updates: only the walls that
+	 * were added, deleted or moved since the last synchronise() are rasterized again.
+	 */
+	class OccupancyGrid
+	{
+		public:
+			/**
+			 * An inclusive rectangle of cells
+			 */
+			struct Area
+			{
+				int left;
+				int top;
+				int right;
+				int bottom;
+			};
+			/**
+			 * The eight directions to the neighbours of a cell. They start at (0,1) and turn counter clockwise,
+			 * bit i of getFreeNeighbours() is direction i and the opposite of direction i is direction (i + 4) % 8.
+			 * The cost of a step is its length.
+			 */
+			static constexpr int DirectionCount = 8;
+			static constexpr int XOffset[DirectionCount] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+			static constexpr int YOffset[DirectionCount] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+			static constexpr double StepCost[DirectionCount] = { 1.0, 1.4142135623730951, 1.0, 1.4142135623730951, 1.0, 1.4142135623730951, 1.0, 1.4142135623730951 };
+			/**
+			 *
+			 */
+			OccupancyGrid();
+			/**
+			 * Brings the grid up to date with the walls for the given free radius. Nothing is done if neither the
+			 * radius nor the geometry version of the world changed since the previous call.
+			 */
+			void synchronise(	const std::vector< Model::WallPtr >& aWalls,
+								int aFreeRadius,
+								unsigned long aGeometryVersion);
+			/**
+			 *
+			 * @return true if a robot with the free radius of this grid does not fit at (anX,anY)
+			 */
+			bool isBlocked(	int anX,
+							int anY) const
+			{
+				int column = anX - left;
+				int row = anY - top;
+				if (column < 0 || column >= width || row < 0 || row >= height)
+				{
+					return false;
+				}
+				std::size_t cell = static_cast< std::size_t >( row * width + column);
+				return (blocked[cell >> 6] >> (cell & 63)) & 1U;
+			}
+			/**
+			 * The free neighbours of (anX,anY) as a mask: bit i is set if the neighbour in direction i of XOffset
+			 * and YOffset is free. Away from the border the three rows of three cells are read as three bit fields
+			 * from the bitmap instead of as eight separate cells.
+			 */
+			std::uint8_t getFreeNeighbours(	int anX,
+											int anY) const;
+			/**
+			 * Walks every cell that the line from (aFromX,aFromY) to (aToX,aToY) touches, including both cells
+			 * next to a corner that the line passes exactly.
+			 *
+			 * @return true if none of those cells is blocked
+			 */
+			bool isLineFree(	int aFromX,
+								int aFromY,
+								int aToX,
+								int aToY) const;
+			/**
+			 *
+			 */
+			int getFreeRadius() const
+			{
+				return freeRadius;
+			}
+			/**
+			 *
+			 */
+			int getLeft() const
+			{
+				return left;
+			}
+			/**
+			 *
+			 */
+			int getTop() const
+			{
+				return top;
+			}
+			/**
+			 *
+			 */
+			int getWidth() const
+			{
+				return width;
+			}
+			/**
+			 *
+			 */
+			int getHeight() const
+			{
+				return height;
+			}
+			/**
+			 *
+			 */
+			unsigned long getGeometryVersion() const
+			{
+				return geometryVersion;
+			}
+			/**
+			 * The number of full rebuilds so far. If this did not change the bounds did not change either
+			 * and getChangedAreas() tells what changed.
+			 */
+			unsigned long getRebuildCount() const
+			{
+				return rebuildCount;
+			}
+			/**
+			 * The geometry version the grid was synchronised from by the latest synchronise() that changed
+			 * anything. Only a user that is up to date with that version can rely on getChangedAreas().
+			 */
+			unsigned long getChangedSinceVersion() const
+			{
+				return changedSinceVersion;
+			}
+			/**
+			 * The areas that were rasterized by the latest synchronise() that changed anything
+			 */
+			const std::vector< Area >& getChangedAreas() const
+			{
+				return changedAreas;
+			}
+
+		private:
+			typedef std::pair< wxPoint, wxPoint > Segment;
+			/**
+			 * Rebuilds the whole grid with bounds that fit all walls
+			 */
+			void rebuild( const std::vector< Model::WallPtr >& aWalls);
+			/**
+			 *
+			 * @return true if the inflated segment fits in the current bounds
+			 */
+			bool fits( const Segment& aSegment) const;
+			/**
+			 * Adds (aDelta = 1) or removes (aDelta = -1) the inflated segment
+			 */
+			void rasterize(	const Segment& aSegment,
+							int aDelta);
+			/**
+			 * @return the blocked bits of the three cells from (aColumn,aRow) to the east, the western one in bit 0
+			 */
+			unsigned int getThreeCells(	int aColumn,
+										int aRow) const
+			{
+				std::size_t cell = static_cast< std::size_t >( aRow * width + aColumn);
+				std::size_t word = cell >> 6;
+				unsigned int shift = static_cast< unsigned int >( cell & 63);
+				std::uint64_t bits = blocked[word] >> shift;
+				// The cells may continue in the next word
+				if (shift > 61)
+				{
+					bits |= blocked[word + 1] << (64 - shift);
+				}
+				return static_cast< unsigned int >( bits & 7U);
+			}
+
+			int left;
+			int top;
+			int width;
+			int height;
+			int freeRadius;
+			unsigned long geometryVersion;
+			unsigned long changedSinceVersion;
+			unsigned long rebuildCount;
+			bool valid;
+			/**
+			 * The number of walls that block the cell
+			 */
+			std::vector< std::uint16_t > counts;
+			/**
+			 * One bit per cell, set if the count is not zero
+			 */
+			std::vector< std::uint64_t > blocked;
+			/**
+			 * The segments as they were rasterized, to find out what changed
+			 */
+			std::unordered_map< const Model::Wall*, Segment > segments;
+			/**
+			 *
+			 */
+			std::vector< Area > changedAreas;
+	}; // class OccupancyGrid
+} // namespace PathAlgorithm
+#endif // OCCUPANCYGRID_HPP_
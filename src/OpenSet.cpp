@@ -0,0 +1,166 @@
+#include "OpenSet.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	void OpenSet::clear()
+	{
+		heap.clear();
+		positions.clear();
+	}
+	/**
+	 *
+	 */
+	void OpenSet::push( const Vertex& aVertex)
+	{
+		iterator i = find( aVertex);
+		if (i != heap.end())
+		{
+			update( i, aVertex);
+			return;
+		}
+		// A full heap grows, every new entry of the index is a node of its own and may rehash the index
+		std::size_t bucketCount = positions.bucket_count();
+		allocationCount += heap.size() == heap.capacity() ? 2 : 1;
+		heap.push_back( aVertex);
+		positions[cellKey( aVertex)] = heap.size() - 1;
+		if (positions.bucket_count() != bucketCount)
+		{
+			++allocationCount;
+		}
+		siftUp( heap.size() - 1);
+	}
+	/**
+	 *
+	 */
+	void OpenSet::pop()
+	{
+		erase( heap.begin());
+	}
+	/**
+	 *
+	 */
+	OpenSet::iterator OpenSet::find( const Vertex& aVertex)
+	{
+		auto i = positions.find( cellKey( aVertex));
+		if (i == positions.end())
+		{
+			return heap.end();
+		}
+		return heap.begin() + static_cast< std::ptrdiff_t >( i->second);
+	}
+	/**
+	 *
+	 */
+	OpenSet::const_iterator OpenSet::find( const Vertex& aVertex) const
+	{
+		auto i = positions.find( cellKey( aVertex));
+		if (i == positions.end())
+		{
+			return heap.end();
+		}
+		return heap.begin() + static_cast< std::ptrdiff_t >( i->second);
+	}
+	/**
+	 *
+	 */
+	void OpenSet::update(	iterator i,
+							const Vertex& aVertex)
+	{
+		std::size_t position = static_cast< std::size_t >( i - heap.begin());
+		bool decrease = aVertex.lessCost( heap[position]);
+		heap[position] = aVertex;
+		if (decrease)
+		{
+			siftUp( position);
+		} else
+		{
+			siftDown( position);
+		}
+	}
+	/**
+	 *
+	 */
+	void OpenSet::erase( iterator i)
+	{
+		std::size_t position = static_cast< std::size_t >( i - heap.begin());
+		positions.erase( cellKey( heap[position]));
+
+		std::size_t last = heap.size() - 1;
+		if (position != last)
+		{
+			place( position, heap[last]);
+			heap.pop_back();
+			// The moved Vertex may have to go either way
+			siftUp( position);
+			siftDown( position);
+		} else
+		{
+			heap.pop_back();
+		}
+	}
+	/**
+	 *
+	 */
+	void OpenSet::place(	std::size_t aPosition,
+							const Vertex& aVertex)
+	{
+		heap[aPosition] = aVertex;
+		positions[cellKey( aVertex)] = aPosition;
+	}
+	/**
+	 *
+	 */
+	void OpenSet::siftUp( std::size_t aPosition)
+	{
+		if (aPosition >= heap.size())
+		{
+			return;
+		}
+		Vertex vertex = heap[aPosition];
+		while (aPosition > 0)
+		{
+			std::size_t parent = (aPosition - 1) / 2;
+			if (!vertex.lessCost( heap[parent]))
+			{
+				break;
+			}
+			place( aPosition, heap[parent]);
+			aPosition = parent;
+		}
+		place( aPosition, vertex);
+	}
+	/**
+	 *
+	 */
+	void OpenSet::siftDown( std::size_t aPosition)
+	{
+		if (aPosition >= heap.size())
+		{
+			return;
+		}
+		Vertex vertex = heap[aPosition];
+		std::size_t size = heap.size();
+		for (;;)
+		{
+			std::size_t child = 2 * aPosition + 1;
+			if (child >= size)
+			{
+				break;
+			}
+			if (child + 1 < size && heap[child + 1].lessCost( heap[child]))
+			{
+				++child;
+			}
+			if (!heap[child].lessCost( vertex))
+			{
+				break;
+			}
+			place( aPosition, heap[child]);
+			aPosition = child;
+		}
+		place( aPosition, vertex);
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,151 @@
+#ifndef OPENSET_HPP_
+#define OPENSET_HPP_
+
+#include "Config.hpp"
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * The OpenSet is an indexed binary min-heap of Vertices ordered by VertexLessCostCompare.
+	 * Every grid cell is at most once in the OpenSet: the index maps the cell to its position
+	 * in the heap which makes finding a Vertex O(1) and a decrease-key O(log n).
+	 *
+	 * Iterating over the OpenSet visits the Vertices in heap order, not in cost order.
+	 */
+	class OpenSet
+	{
+		public:
+			typedef std::vector< Vertex >::iterator iterator;
+			typedef std::vector< Vertex >::const_iterator const_iterator;
+			/**
+			 *
+			 */
+			bool empty() const
+			{
+				return heap.empty();
+			}
+			/**
+			 *
+			 */
+			std::size_t size() const
+			{
+				return heap.size();
+			}
+			/**
+			 *
+			 */
+			void clear();
+			/**
+			 *
+			 * @return the Vertex with the least cost
+			 */
+			const Vertex& front() const
+			{
+				return heap.front();
+			}
+			/**
+			 * Adds the Vertex or, if its cell is already in the OpenSet, replaces the Vertex in that cell
+			 */
+			void push( const Vertex& aVertex);
+			/**
+			 * Removes the Vertex with the least cost
+			 */
+			void pop();
+			/**
+			 *
+			 * @return an iterator to the Vertex in the same cell as aVertex, end() otherwise
+			 */
+			iterator find( const Vertex& aVertex);
+			/**
+			 *
+			 * @return an iterator to the Vertex in the same cell as aVertex, end() otherwise
+			 */
+			const_iterator find( const Vertex& aVertex) const;
+			/**
+			 * Replaces the Vertex at the given position and restores the heap order
+			 */
+			void update(	iterator i,
+							const Vertex& aVertex);
+			/**
+			 *
+			 */
+			void erase( iterator i);
+			/**
+			 *
+			 * @return the number of times the heap or its index allocated memory since the OpenSet was made
+			 */
+			std::size_t getAllocationCount() const
+			{
+				return allocationCount;
+			}
+			/**
+			 *
+			 */
+			iterator begin()
+			{
+				return heap.begin();
+			}
+			/**
+			 *
+			 */
+			iterator end()
+			{
+				return heap.end();
+			}
+			/**
+			 *
+			 */
+			const_iterator begin() const
+			{
+				return heap.begin();
+			}
+			/**
+			 *
+			 */
+			const_iterator end() const
+			{
+				return heap.end();
+			}
+
+		private:
+			/**
+			 *
+			 */
+			static std::uint64_t cellKey( const Vertex& aVertex)
+			{
+				return (static_cast< std::uint64_t >( static_cast< std::uint32_t >( aVertex.x)) << 32) | static_cast< std::uint32_t >( aVertex.y);
+			}
+			/**
+			 *
+			 */
+			void place(	std::size_t aPosition,
+						const Vertex& aVertex);
+			/**
+			 *
+			 */
+			void siftUp( std::size_t aPosition);
+			/**
+			 *
+			 */
+			void siftDown( std::size_t aPosition);
+			/**
+			 *
+			 */
+			std::vector< Vertex > heap;
+			/**
+			 * Maps a cell to the position of its Vertex in the heap
+			 */
+			std::unordered_map< std::uint64_t, std::size_t > positions;
+			/**
+			 *
+			 */
+			std::size_t allocationCount = 0;
+	}; // class OpenSet
+} // namespace PathAlgorithm
+#endif // OPENSET_HPP_
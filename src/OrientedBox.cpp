@@ -0,0 +1,137 @@
+#include "OrientedBox.hpp"
+
+#include <cmath>
+
+namespace Utils
+{
+	/**
+	 *
+	 */
+	OrientedBox::OrientedBox(	double aCentreX,
+								double aCentreY,
+								double anAngle,
+								double aHalfLength,
+								double aHalfWidth) :
+		centreX( aCentreX),
+		centreY( aCentreY),
+		axisX( std::cos( anAngle)),
+		axisY( std::sin( anAngle)),
+		halfLength( std::fabs( aHalfLength)),
+		halfWidth( std::fabs( aHalfWidth))
+	{
+	}
+	/**
+	 *
+	 */
+	OrientedBox::OrientedBox(	double aCentreX,
+								double aCentreY,
+								double anAxisX,
+								double anAxisY,
+								double aHalfLength,
+								double aHalfWidth) :
+		centreX( aCentreX),
+		centreY( aCentreY),
+		axisX( anAxisX),
+		axisY( anAxisY),
+		halfLength( std::fabs( aHalfLength)),
+		halfWidth( std::fabs( aHalfWidth))
+	{
+	}
+	/**
+	 *
+	 */
+	/* static */ OrientedBox OrientedBox::fromRectangle(	const wxPoint& aCentre,
+															const wxSize& aSize)
+	{
+		return OrientedBox( aCentre.x, aCentre.y, 0.0, aSize.x / 2.0, aSize.y / 2.0);
+	}
+	/**
+	 *
+	 */
+	/* static */ OrientedBox OrientedBox::fromAxis(	double aCentreX,
+													double aCentreY,
+													double anAxisX,
+													double anAxisY,
+													double aHalfLength,
+													double aHalfWidth)
+	{
+		return OrientedBox( aCentreX, aCentreY, anAxisX, anAxisY, aHalfLength, aHalfWidth);
+	}
+	/**
+	 *
+	 */
+	double OrientedBox::projectedRadius(	double anX,
+											double anY) const
+	{
+		// The length axis is (axisX,axisY), the width axis is (-axisY,axisX)
+		return halfLength * std::fabs( axisX * anX + axisY * anY) + halfWidth * std::fabs( -axisY * anX + axisX * anY);
+	}
+	/**
+	 *
+	 */
+	bool OrientedBox::intersects( const OrientedBox& aBox) const
+	{
+		double dx = aBox.centreX - centreX;
+		double dy = aBox.centreY - centreY;
+
+		// The edge normals of both boxes are their length and width axes
+		const double axes[4][2] = { { axisX, axisY }, { -axisY, axisX }, { aBox.axisX, aBox.axisY }, { -aBox.axisY, aBox.axisX } };
+		for (const auto& axis : axes)
+		{
+			double distance = std::fabs( dx * axis[0] + dy * axis[1]);
+			if (distance > projectedRadius( axis[0], axis[1]) + aBox.projectedRadius( axis[0], axis[1]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	bool OrientedBox::intersects(	const wxPoint& aStart,
+									const wxPoint& anEnd) const
+	{
+		// The segment is a box without width around its middle
+		double segmentX = anEnd.x - aStart.x;
+		double segmentY = anEnd.y - aStart.y;
+		double dx = (aStart.x + anEnd.x) / 2.0 - centreX;
+		double dy = (aStart.y + anEnd.y) / 2.0 - centreY;
+
+		const double axes[3][2] = { { axisX, axisY }, { -axisY, axisX }, { -segmentY, segmentX } };
+		for (const auto& axis : axes)
+		{
+			// The normal of the segment is not a unit vector, both sides scale with it
+			double distance = std::fabs( dx * axis[0] + dy * axis[1]);
+			double segmentRadius = std::fabs( segmentX * axis[0] + segmentY * axis[1]) / 2.0;
+			if (distance > projectedRadius( axis[0], axis[1]) + segmentRadius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	bool OrientedBox::contains( const wxPoint& aPoint) const
+	{
+		double dx = aPoint.x - centreX;
+		double dy = aPoint.y - centreY;
+		return std::fabs( dx * axisX + dy * axisY) <= halfLength && std::fabs( -dx * axisY + dy * axisX) <= halfWidth;
+	}
+	/**
+	 *
+	 */
+	std::array< wxPoint, 4 > OrientedBox::getCorners() const
+	{
+		double lengthX = axisX * halfLength;
+		double lengthY = axisY * halfLength;
+		double widthX = -axisY * halfWidth;
+		double widthY = axisX * halfWidth;
+		return { wxPoint( static_cast< int >( std::lround( centreX + lengthX + widthX)), static_cast< int >( std::lround( centreY + lengthY + widthY))),
+				 wxPoint( static_cast< int >( std::lround( centreX + lengthX - widthX)), static_cast< int >( std::lround( centreY + lengthY - widthY))),
+				 wxPoint( static_cast< int >( std::lround( centreX - lengthX - widthX)), static_cast< int >( std::lround( centreY - lengthY - widthY))),
+				 wxPoint( static_cast< int >( std::lround( centreX - lengthX + widthX)), static_cast< int >( std::lround( centreY - lengthY + widthY))) };
+	}
+} // namespace Utils
@@ -0,0 +1,124 @@
+#ifndef ORIENTEDBOX_HPP_
+#define ORIENTEDBOX_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+
+#include <array>
+
+namespace Utils
+{
+	/**
+	 * An OrientedBox is a rectangle that may be rotated: a centre, the unit vector of its length axis and the
+	 * half of its length and its width. Whether it overlaps another box or a line segment is decided with the
+	 * separating axis theorem, in plain arithmetic without any regions of the GUI toolkit: two convex shapes are
+	 * apart if and only if their projections on one of the edge normals of either shape are apart.
+	 *
+	 * Shapes that only touch overlap.
+	 */
+	class OrientedBox
+	{
+		public:
+			/**
+			 *
+			 * @param aCentreX, aCentreY The centre of the box
+			 * @param anAngle The counterclockwise angle in radians between the positive X axis and the length axis
+			 * @param aHalfLength Half of the size along the length axis
+			 * @param aHalfWidth Half of the size perpendicular to the length axis
+			 */
+			OrientedBox(	double aCentreX,
+							double aCentreY,
+							double anAngle,
+							double aHalfLength,
+							double aHalfWidth);
+			/**
+			 * @return the box of aSize centred at aCentre that is not rotated, the length axis is the X axis
+			 */
+			static OrientedBox fromRectangle(	const wxPoint& aCentre,
+												const wxSize& aSize);
+			/**
+			 * @return the box with the length axis (anAxisX,anAxisY), which must be a unit vector, for callers that
+			 * already know the cosine and the sine of the angle
+			 */
+			static OrientedBox fromAxis(	double aCentreX,
+											double aCentreY,
+											double anAxisX,
+											double anAxisY,
+											double aHalfLength,
+											double aHalfWidth);
+			/**
+			 *
+			 */
+			bool intersects( const OrientedBox& aBox) const;
+			/**
+			 *
+			 * @return true if the line segment from aStart to anEnd touches or crosses the box or lies inside it
+			 */
+			bool intersects(	const wxPoint& aStart,
+								const wxPoint& anEnd) const;
+			/**
+			 *
+			 */
+			bool contains( const wxPoint& aPoint) const;
+			/**
+			 * The corners going around the box, the first two are those at the front end of the length axis
+			 */
+			std::array< wxPoint, 4 > getCorners() const;
+			/**
+			 *
+			 */
+			double getCentreX() const
+			{
+				return centreX;
+			}
+			double getCentreY() const
+			{
+				return centreY;
+			}
+			/**
+			 * The unit vector of the length axis
+			 */
+			double getAxisX() const
+			{
+				return axisX;
+			}
+			double getAxisY() const
+			{
+				return axisY;
+			}
+			double getHalfLength() const
+			{
+				return halfLength;
+			}
+			double getHalfWidth() const
+			{
+				return halfWidth;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			OrientedBox(	double aCentreX,
+							double aCentreY,
+							double anAxisX,
+							double anAxisY,
+							double aHalfLength,
+							double aHalfWidth);
+			/**
+			 *
+			 * @return the half of the extent of the box when projected on the unit vector (anX,anY)
+			 */
+			double projectedRadius(	double anX,
+									double anY) const;
+
+			double centreX;
+			double centreY;
+			double axisX;
+			double axisY;
+			double halfLength;
+			double halfWidth;
+	}; // class OrientedBox
+} // namespace Utils
+#endif // ORIENTEDBOX_HPP_
@@ -0,0 +1,188 @@
+#include "PathCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 * Rounds towards minus infinity, unlike the integer division
+		 */
+		int Quantize(	int aValue,
+						int aQuantum)
+		{
+			return aValue >= 0 ? aValue / aQuantum : -((-aValue + aQuantum - 1) / aQuantum);
+		}
+		/**
+		 * The number of straight or diagonal steps from aStart to aGoal
+		 */
+		std::size_t Steps(	const wxPoint& aStart,
+							const wxPoint& aGoal)
+		{
+			return static_cast< std::size_t >( std::max( std::abs( aGoal.x - aStart.x), std::abs( aGoal.y - aStart.y)));
+		}
+		/**
+		 * Writes the cells after aStart up to and including aGoal, straight or diagonal steps
+		 */
+		Path::iterator Connect(	wxPoint aStart,
+								const wxPoint& aGoal,
+								Path::iterator anOutput)
+		{
+			while (aStart != aGoal)
+			{
+				aStart.x += (aGoal.x > aStart.x) - (aGoal.x < aStart.x);
+				aStart.y += (aGoal.y > aStart.y) - (aGoal.y < aStart.y);
+				*anOutput++ = Vertex( aStart);
+			}
+			return anOutput;
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	bool PathCache::Key::operator==( const Key& aKey) const
+	{
+		return startX == aKey.startX && startY == aKey.startY && goalX == aKey.goalX && goalY == aKey.goalY &&
+			   freeRadius == aKey.freeRadius && planner == aKey.planner && geometryVersion == aKey.geometryVersion;
+	}
+	/**
+	 *
+	 */
+	std::size_t PathCache::KeyHash::operator()( const Key& aKey) const
+	{
+		std::size_t hash = std::hash< unsigned long >()( aKey.geometryVersion);
+		for (int value : { aKey.startX, aKey.startY, aKey.goalX, aKey.goalY, aKey.freeRadius, aKey.planner })
+		{
+			hash ^= std::hash< int >()( value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		}
+		return hash;
+	}
+	/**
+	 *
+	 */
+	PathCache::PathCache(	std::size_t aCapacity /*= 65536*/,
+							int aQuantum /*= 4*/) :
+		capacity( aCapacity),
+		quantum( std::max( aQuantum, 1)),
+		vertexCount( 0),
+		geometryVersion( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	bool PathCache::find(	const wxPoint& aStart,
+							const wxPoint& aGoal,
+							int aFreeRadius,
+							int aPlanner,
+							unsigned long aGeometryVersion,
+							Path& aPath)
+	{
+		auto i = index.find( makeKey( aStart, aGoal, aFreeRadius, aPlanner, aGeometryVersion));
+		if (i == index.end())
+		{
+			return false;
+		}
+
+		// Most recently used
+		entries.splice( entries.begin(), entries, i->second);
+		const Path& path = i->second->path;
+
+		// The cached path runs between points in the same cells as aStart and aGoal
+		wxPoint first( path.front().x, path.front().y);
+		wxPoint last( path.back().x, path.back().y);
+
+		// assign() only allocates if the capacity of the previous path is too small
+		aPath.assign( Steps( aStart, first) + path.size() + Steps( last, aGoal), Vertex( 0, 0));
+		aPath.front() = Vertex( aStart);
+		Path::iterator output = Connect( aStart, first, aPath.begin() + 1);
+		output = std::copy( path.begin() + 1, path.end(), output);
+		Connect( last, aGoal, output);
+
+		aPath.front().actualCost = 0.0;
+		for (std::size_t j = 1; j < aPath.size(); ++j)
+		{
+			int dx = aPath[j].x - aPath[j - 1].x;
+			int dy = aPath[j].y - aPath[j - 1].y;
+			aPath[j].actualCost = aPath[j - 1].actualCost + std::sqrt( dx * dx + dy * dy);
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	void PathCache::insert(	const wxPoint& aStart,
+							const wxPoint& aGoal,
+							int aFreeRadius,
+							int aPlanner,
+							unsigned long aGeometryVersion,
+							const Path& aPath)
+	{
+		if (aPath.empty() || aPath.size() > capacity)
+		{
+			return;
+		}
+
+		// Paths of an older geometry will never be found again
+		if (aGeometryVersion != geometryVersion)
+		{
+			clear();
+			geometryVersion = aGeometryVersion;
+		}
+
+		Key key = makeKey( aStart, aGoal, aFreeRadius, aPlanner, aGeometryVersion);
+		auto i = index.find( key);
+		if (i != index.end())
+		{
+			erase( i->second);
+		}
+
+		while (vertexCount + aPath.size() > capacity)
+		{
+			erase( std::prev( entries.end()));
+		}
+
+		entries.push_front( Entry{ key, aPath });
+		index.emplace( key, entries.begin());
+		vertexCount += aPath.size();
+	}
+	/**
+	 *
+	 */
+	void PathCache::clear()
+	{
+		entries.clear();
+		index.clear();
+		vertexCount = 0;
+	}
+	/**
+	 *
+	 */
+	PathCache::Key PathCache::makeKey(	const wxPoint& aStart,
+										const wxPoint& aGoal,
+										int aFreeRadius,
+										int aPlanner,
+										unsigned long aGeometryVersion) const
+	{
+		return Key{ Quantize( aStart.x, quantum),
+					Quantize( aStart.y, quantum),
+					Quantize( aGoal.x, quantum),
+					Quantize( aGoal.y, quantum),
+					aFreeRadius,
+					aPlanner,
+					aGeometryVersion };
+	}
+	/**
+	 *
+	 */
+	void PathCache::erase( std::list< Entry >::iterator anEntry)
+	{
+		vertexCount -= anEntry->path.size();
+		index.erase( anEntry->key);
+		entries.erase( anEntry);
+	}
+} // namespace PathAlgorithm
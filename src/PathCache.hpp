@@ -0,0 +1,128 @@
+#ifndef PATHCACHE_HPP_
+#define PATHCACHE_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+#include "Point.hpp"
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+
+namespace PathAlgorithm
+{
+	/**
+	 * A least-recently-used cache of paths. A path is found again for a start and a goal that are in the same
+	 * cells of a coarse grid (the quantum) as the ones it was searched for, with the same free radius, the same
+	 * planner and the same geometry version of the world. The cached path is then connected to the actual start
+	 * and goal with straight or diagonal steps.
+	 *
+	 * The memory is bounded by the total number of Vertices in the cache. The geometry version only grows, so all
+	 * paths of an older version are dropped as soon as a path of a newer version is inserted.
+	 */
+	class PathCache
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit PathCache(	std::size_t aCapacity = 65536,
+								int aQuantum = 4);
+			/**
+			 * Writes the cached path from aStart to aGoal into aPath, reusing its storage
+			 *
+			 * @return true if the path was found, aPath is unchanged otherwise
+			 */
+			bool find(	const wxPoint& aStart,
+						const wxPoint& aGoal,
+						int aFreeRadius,
+						int aPlanner,
+						unsigned long aGeometryVersion,
+						Path& aPath);
+			/**
+			 * Inserts (or replaces) the path from aStart to aGoal. Paths that are larger than the capacity are not cached.
+			 */
+			void insert(	const wxPoint& aStart,
+							const wxPoint& aGoal,
+							int aFreeRadius,
+							int aPlanner,
+							unsigned long aGeometryVersion,
+							const Path& aPath);
+			/**
+			 *
+			 */
+			void clear();
+			/**
+			 *
+			 * @return the number of paths in the cache
+			 */
+			std::size_t size() const
+			{
+				return entries.size();
+			}
+			/**
+			 *
+			 * @return the number of Vertices in the cache
+			 */
+			std::size_t getVertexCount() const
+			{
+				return vertexCount;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			struct Key
+			{
+				int startX;
+				int startY;
+				int goalX;
+				int goalY;
+				int freeRadius;
+				int planner;
+				unsigned long geometryVersion;
+
+				bool operator==( const Key& aKey) const;
+			};
+			/**
+			 *
+			 */
+			struct KeyHash
+			{
+				std::size_t operator()( const Key& aKey) const;
+			};
+			/**
+			 *
+			 */
+			struct Entry
+			{
+				Key key;
+				Path path;
+			};
+			/**
+			 *
+			 */
+			Key makeKey(	const wxPoint& aStart,
+							const wxPoint& aGoal,
+							int aFreeRadius,
+							int aPlanner,
+							unsigned long aGeometryVersion) const;
+			/**
+			 *
+			 */
+			void erase( std::list< Entry >::iterator anEntry);
+
+			std::size_t capacity;
+			int quantum;
+			std::size_t vertexCount;
+			unsigned long geometryVersion;
+			/**
+			 * The most recently used entry is the first
+			 */
+			std::list< Entry > entries;
+			std::unordered_map< Key, std::list< Entry >::iterator, KeyHash > index;
+	}; // class PathCache
+} // namespace PathAlgorithm
+#endif // PATHCACHE_HPP_
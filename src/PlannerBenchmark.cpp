@@ -0,0 +1,124 @@
+#include "PlannerBenchmark.hpp"
+
+#include "BidirectionalAStar.hpp"
+#include "DStarLite.hpp"
+#include "Goal.hpp"
+#include "HierarchicalAStar.hpp"
+#include "JumpPointSearch.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Trace.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Application
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		double Milliseconds(	std::chrono::steady_clock::time_point aStart,
+								std::chrono::steady_clock::time_point anEnd)
+		{
+			return std::chrono::duration< double, std::milli >( anEnd - aStart).count();
+		}
+		/**
+		 *
+		 */
+		double Length( const PathAlgorithm::Path& aPath)
+		{
+			double length = 0.0;
+			for (std::size_t i = 1; i < aPath.size(); ++i)
+			{
+				length += std::hypot( aPath[i].x - aPath[i - 1].x, aPath[i].y - aPath[i - 1].y);
+			}
+			return length;
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	/* static */ void PlannerBenchmark::run(	std::ostream& anOutput,
+												unsigned long aRepetitions /*= 3*/,
+												Format aFormat /*= TableFormat*/)
+	{
+		// The searches log the size of the robot. The benchmark runs without a window and without driving
+		// robots, so nothing else is silenced by turning off the tracing while it runs.
+		bool traceEnabled = Base::Trace::isTraceEnabled();
+		Base::Trace::enableTrace( false);
+
+		if (aFormat == TableFormat)
+		{
+			anOutput << std::left << std::setw( 7) << "world" << std::setw( 20) << "planner" << std::right << std::setw( 10) << "expanded"
+					 << std::setw( 10) << "peak" << std::setw( 10) << "reopened" << std::setw( 12) << "wall checks" << std::setw( 8) << "allocs"
+					 << std::setw( 10) << "cold ms" << std::setw( 10) << "warm ms" << std::setw( 10) << "length" << std::endl;
+		}
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		for (int world = 0; world <= 6; ++world)
+		{
+			robotWorld.unpopulate( false);
+			robotWorld.populate( world);
+
+			Model::RobotPtr robot = robotWorld.getRobot( "Robot");
+			Model::GoalPtr goal = robotWorld.getGoal( "Goal");
+			if (!robot || !goal)
+			{
+				continue;
+			}
+			// Without a window there is no RobotShape that sizes the robot to its title
+			wxSize robotSize = robot->getSize();
+			if (robotSize == wxDefaultSize)
+			{
+				robotSize = wxSize( 37, 29); // @suppress("Avoid magic numbers")
+			}
+
+			std::vector< std::pair< std::string, std::unique_ptr< PathAlgorithm::AStar > > > planners;
+			planners.emplace_back( "A*", std::make_unique< PathAlgorithm::AStar >());
+			planners.emplace_back( "Bidirectional A*", std::make_unique< PathAlgorithm::BidirectionalAStar >());
+			planners.emplace_back( "Jump Point Search", std::make_unique< PathAlgorithm::JumpPointSearch >());
+			planners.emplace_back( "Hierarchical A*", std::make_unique< PathAlgorithm::HierarchicalAStar >());
+			planners.emplace_back( "D* Lite", std::make_unique< PathAlgorithm::DStarLite >());
+
+			for (auto& [name, planner] : planners)
+			{
+				PathAlgorithm::Path path;
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				PathAlgorithm::SearchStats stats = planner->search( robot->getPosition(), goal->getPosition(), robotSize, path);
+				double cold = Milliseconds( start, std::chrono::steady_clock::now());
+
+				start = std::chrono::steady_clock::now();
+				for (unsigned long i = 0; i < aRepetitions; ++i)
+				{
+					planner->search( robot->getPosition(), goal->getPosition(), robotSize, path);
+				}
+				double warm = aRepetitions > 0 ? Milliseconds( start, std::chrono::steady_clock::now()) / static_cast< double >( aRepetitions) : 0.0;
+
+				if (aFormat == JsonFormat)
+				{
+					anOutput << "{\"world\":" << world << ",\"planner\":\"" << name << "\",\"stats\":" << stats.asJson()
+							 << std::fixed << std::setprecision( 3) << ",\"warmMs\":" << warm << ",\"length\":" << Length( path) << "}" << std::endl;
+				} else
+				{
+					anOutput << std::left << std::setw( 7) << world << std::setw( 20) << name << std::right << std::setw( 10) << stats.expandedCount
+							 << std::setw( 10) << stats.openSetPeak << std::setw( 10) << stats.reopenedCount << std::setw( 12) << stats.wallCheckCount
+							 << std::setw( 8) << stats.allocationCount
+							 << std::fixed << std::setprecision( 2) << std::setw( 10) << cold << std::setw( 10) << warm << std::setw( 10) << Length( path)
+							 << std::endl;
+				}
+			}
+		}
+		robotWorld.unpopulate( false);
+
+		Base::Trace::enableTrace( traceEnabled);
+	}
+} // namespace Application
@@ -0,0 +1,35 @@
+#ifndef PLANNERBENCHMARK_HPP_
+#define PLANNERBENCHMARK_HPP_
+
+#include "Config.hpp"
+
+#include <iosfwd>
+
+namespace Application
+{
+	/**
+	 * Runs every path planner from the robot named "Robot" to the goal named "Goal" in every built-in world
+	 * and writes the statistics of the first search, the time of the first (cold) and the mean of the next (warm)
+	 * searches and the length of the path. Start the application with -benchmark to run it, or with
+	 * -benchmark=json to write one JSON object per line for regression tracking.
+	 */
+	class PlannerBenchmark
+	{
+		public:
+			/**
+			 *
+			 */
+			enum Format
+			{
+				TableFormat,
+				JsonFormat
+			};
+			/**
+			 *
+			 */
+			static void run(	std::ostream& anOutput,
+								unsigned long aRepetitions = 3,
+								Format aFormat = TableFormat);
+	}; // class PlannerBenchmark
+} // namespace Application
+#endif // PLANNERBENCHMARK_HPP_
@@ -0,0 +1,113 @@
+#include "PlanningPool.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	/* static */ PlanningPool& PlanningPool::getPlanningPool()
+	{
+		static PlanningPool planningPool( std::max( std::thread::hardware_concurrency(), 1U));
+		return planningPool;
+	}
+	/**
+	 *
+	 */
+	PlanningPool::PlanningPool( std::size_t aThreadCount)
+	{
+		for (std::size_t i = 0; i < aThreadCount; ++i)
+		{
+			workers.push_back( std::thread( [this]{work();}));
+		}
+	}
+	/**
+	 *
+	 */
+	PlanningPool::~PlanningPool()
+	{
+		jobs.shutDown();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+	/**
+	 *
+	 */
+	std::future< Path > PlanningPool::plan(	AStar& aPlanner,
+											const wxPoint& aStartPoint,
+											const wxPoint& aGoalPoint,
+											const wxSize& aRobotSize,
+											SearchStats* aStats /*= nullptr*/)
+	{
+		// The queue copies its elements and a packaged_task can only be moved, hence the shared_ptr
+		std::shared_ptr< std::packaged_task< Path() > > task = std::make_shared< std::packaged_task< Path() > >(
+			[&aPlanner, aStartPoint, aGoalPoint, aRobotSize, aStats]
+			{
+				Path path;
+				SearchStats stats = aPlanner.search( aStartPoint, aGoalPoint, aRobotSize, path);
+				if (aStats)
+				{
+					*aStats = stats;
+				}
+				return path;
+			});
+
+		std::future< Path > path = task->get_future();
+		jobs.enqueue( [task]{(*task)();});
+		return path;
+	}
+	/**
+	 *
+	 */
+	std::future< AStar::SearchStatus > PlanningPool::startSearch(	AStar& aPlanner,
+																	const wxPoint& aStartPoint,
+																	const wxPoint& aGoalPoint,
+																	const wxSize& aRobotSize,
+																	std::chrono::milliseconds aBudget,
+																	Path& aPath)
+	{
+		std::shared_ptr< std::packaged_task< AStar::SearchStatus() > > task = std::make_shared< std::packaged_task< AStar::SearchStatus() > >(
+			[&aPlanner, aStartPoint, aGoalPoint, aRobotSize, aBudget, &aPath]
+			{
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + aBudget;
+				aPlanner.startSearch( aStartPoint, aGoalPoint, aRobotSize);
+				return aPlanner.resumeSearch( 0, deadline, aPath);
+			});
+
+		std::future< AStar::SearchStatus > status = task->get_future();
+		jobs.enqueue( [task]{(*task)();});
+		return status;
+	}
+	/**
+	 *
+	 */
+	std::future< AStar::SearchStatus > PlanningPool::resumeSearch(	AStar& aPlanner,
+																	std::chrono::milliseconds aBudget,
+																	Path& aPath)
+	{
+		std::shared_ptr< std::packaged_task< AStar::SearchStatus() > > task = std::make_shared< std::packaged_task< AStar::SearchStatus() > >(
+			[&aPlanner, aBudget, &aPath]
+			{
+				return aPlanner.resumeSearch( 0, std::chrono::steady_clock::now() + aBudget, aPath);
+			});
+
+		std::future< AStar::SearchStatus > status = task->get_future();
+		jobs.enqueue( [task]{(*task)();});
+		return status;
+	}
+	/**
+	 *
+	 */
+	void PlanningPool::work()
+	{
+		// dequeue() only returns nothing after shutDown() and when the queue is empty
+		while (std::optional< std::function< void() > > job = jobs.dequeue())
+		{
+			(*job)();
+		}
+	}
+} // namespace PathAlgorithm
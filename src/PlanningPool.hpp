@@ -0,0 +1,98 @@
+#ifndef PLANNINGPOOL_HPP_
+#define PLANNINGPOOL_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+#include "Point.hpp"
+#include "Queue.hpp"
+#include "Size.hpp"
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * The PlanningPool is a fixed number of worker threads, as many as the hardware supports, that run the
+	 * path searches of all robots. However many robots start at the same time, no more searches than that
+	 * run simultaneously.
+	 *
+	 * A planner must not be used by two searches at the same time: every robot has its own planners and
+	 * waits for its route before it plans the next one.
+	 */
+	class PlanningPool
+	{
+		public:
+			/**
+			 *
+			 */
+			static PlanningPool& getPlanningPool();
+			/**
+			 * Stops the workers after the searches that are queued
+			 */
+			~PlanningPool();
+			/**
+			 * Queues a search of aPlanner. The observers of aPlanner are notified from a worker thread.
+			 * If aStats is given the statistics of the search are written into it before the path is ready.
+			 *
+			 * @return the future of the path, it is empty if there is no route
+			 */
+			std::future< Path > plan(	AStar& aPlanner,
+										const wxPoint& aStartPoint,
+										const wxPoint& aGoalPoint,
+										const wxSize& aRobotSize,
+										SearchStats* aStats = nullptr);
+			/**
+			 * Queues the start of a budgeted search of aPlanner, see AStar::startSearch, and its first step
+			 * of at most aBudget from the moment a worker takes it. The path, partial if the budget ran out,
+			 * is written into aPath, which must be kept alive until the future is ready.
+			 *
+			 * @return the future of the status of the search
+			 */
+			std::future< AStar::SearchStatus > startSearch(	AStar& aPlanner,
+															const wxPoint& aStartPoint,
+															const wxPoint& aGoalPoint,
+															const wxSize& aRobotSize,
+															std::chrono::milliseconds aBudget,
+															Path& aPath);
+			/**
+			 * Queues the next step of at most aBudget of the search that was started with startSearch()
+			 *
+			 * @return the future of the status of the search
+			 */
+			std::future< AStar::SearchStatus > resumeSearch(	AStar& aPlanner,
+																std::chrono::milliseconds aBudget,
+																Path& aPath);
+			/**
+			 *
+			 */
+			std::size_t getThreadCount() const
+			{
+				return workers.size();
+			}
+
+		private:
+			/**
+			 *
+			 */
+			explicit PlanningPool( std::size_t aThreadCount);
+			/**
+			 * The loop of a worker
+			 */
+			void work();
+
+			/**
+			 *
+			 */
+			Base::Queue< std::function< void() > > jobs;
+			/**
+			 *
+			 */
+			std::vector< std::thread > workers;
+	}; // class PlanningPool
+} // namespace PathAlgorithm
+#endif // PLANNINGPOOL_HPP_
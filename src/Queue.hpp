@@ -56,7 +56,10 @@ namespace Base
 			 */
 			void shutDown()
 			{
+				std::unique_lock< std::mutex > lock( queueBusy);
 				stop.store(true);
+				// Wake up everybody that waits in dequeue()
+				queueFull.notify_all();
 			}
 
 		private:
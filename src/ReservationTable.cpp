@@ -0,0 +1,134 @@
+#include "ReservationTable.hpp"
+
+#include <algorithm>
+
+namespace PathAlgorithm
+{
+	namespace
+	{
+		/**
+		 *
+		 */
+		bool Overlap(	const wxPoint& aPosition,
+						const wxPoint& anOtherPosition,
+						int aSeparation)
+		{
+			long dx = aPosition.x - anOtherPosition.x;
+			long dy = aPosition.y - anOtherPosition.y;
+			return dx * dx + dy * dy < static_cast< long >( aSeparation) * aSeparation;
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	/* static */ ReservationTable& ReservationTable::getReservationTable()
+	{
+		static ReservationTable reservationTable;
+		return reservationTable;
+	}
+	/**
+	 *
+	 */
+	ReservationTable::ReservationTable() :
+		epoch( std::chrono::steady_clock::now())
+	{
+	}
+	/**
+	 *
+	 */
+	ReservationTable::Tick ReservationTable::getCurrentTick() const
+	{
+		return static_cast< Tick >( (std::chrono::steady_clock::now() - epoch) / getTickDuration());
+	}
+	/**
+	 *
+	 */
+	void ReservationTable::reserve(	const void* anOwner,
+									Tick aStartTick,
+									const std::vector< wxPoint >& aPositions,
+									int aRadius)
+	{
+		std::lock_guard< std::recursive_mutex > guard( mutex);
+		if (aPositions.empty())
+		{
+			reservations.erase( anOwner);
+			return;
+		}
+		reservations[anOwner] = Reservation{ aStartTick, aPositions, aRadius };
+	}
+	/**
+	 *
+	 */
+	void ReservationTable::park(	const void* anOwner,
+									const wxPoint& aPosition,
+									int aRadius)
+	{
+		reserve( anOwner, getCurrentTick(), std::vector< wxPoint >{ aPosition }, aRadius);
+	}
+	/**
+	 *
+	 */
+	void ReservationTable::release( const void* anOwner)
+	{
+		std::lock_guard< std::recursive_mutex > guard( mutex);
+		reservations.erase( anOwner);
+	}
+	/**
+	 *
+	 */
+	bool ReservationTable::hasReservation( const void* anOwner) const
+	{
+		std::lock_guard< std::recursive_mutex > guard( mutex);
+		return reservations.find( anOwner) != reservations.end();
+	}
+	/**
+	 *
+	 */
+	bool ReservationTable::isFree(	const void* anOwner,
+									const wxPoint& aPosition,
+									int aRadius,
+									Tick aTick) const
+	{
+		std::lock_guard< std::recursive_mutex > guard( mutex);
+		for (const auto& [owner, reservation] : reservations)
+		{
+			if (owner == anOwner)
+			{
+				continue;
+			}
+			Tick index = std::max( std::min( aTick - reservation.startTick, static_cast< Tick >( reservation.positions.size()) - 1), Tick( 0));
+			if (Overlap( aPosition, reservation.positions[static_cast< std::size_t >( index)], aRadius + reservation.radius))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	bool ReservationTable::isFreeFrom(	const void* anOwner,
+										const wxPoint& aPosition,
+										int aRadius,
+										Tick aTick) const
+	{
+		std::lock_guard< std::recursive_mutex > guard( mutex);
+		for (const auto& [owner, reservation] : reservations)
+		{
+			if (owner == anOwner)
+			{
+				continue;
+			}
+			// Every position from aTick on, the last one stays forever
+			Tick first = std::max( std::min( aTick - reservation.startTick, static_cast< Tick >( reservation.positions.size()) - 1), Tick( 0));
+			for (std::size_t i = static_cast< std::size_t >( first); i < reservation.positions.size(); ++i)
+			{
+				if (Overlap( aPosition, reservation.positions[i], aRadius + reservation.radius))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,110 @@
+#ifndef RESERVATIONTABLE_HPP_
+#define RESERVATIONTABLE_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * The ReservationTable holds where every robot will be at every tick of a shared clock, so robots can plan
+	 * routes that keep clear of each other in space and time. A robot occupies a circle with its free radius.
+	 * Before its route starts a robot is at the first position of it and after its route ends it stays at the
+	 * last one. The owner of a reservation is only used as a key, usually it is the robot itself.
+	 *
+	 * All functions lock the table. Hold lock() to make several calls atomic, e.g. a search and its reservation.
+	 */
+	class ReservationTable
+	{
+		public:
+			/**
+			 * A tick is one step of a robot, the time a robot sleeps between two steps
+			 */
+			typedef long Tick;
+			/**
+			 *
+			 */
+			static ReservationTable& getReservationTable();
+			/**
+			 *
+			 */
+			static std::chrono::milliseconds getTickDuration()
+			{
+				return std::chrono::milliseconds( 100);
+			}
+			/**
+			 *
+			 */
+			Tick getCurrentTick() const;
+			/**
+			 *
+			 */
+			std::unique_lock< std::recursive_mutex > lock() const
+			{
+				return std::unique_lock< std::recursive_mutex >( mutex);
+			}
+			/**
+			 * Replaces the reservation of anOwner: aPositions[i] is its position at aStartTick + i
+			 */
+			void reserve(	const void* anOwner,
+							Tick aStartTick,
+							const std::vector< wxPoint >& aPositions,
+							int aRadius);
+			/**
+			 * Reserves aPosition for anOwner from now on
+			 */
+			void park(	const void* anOwner,
+						const wxPoint& aPosition,
+						int aRadius);
+			/**
+			 *
+			 */
+			void release( const void* anOwner);
+			/**
+			 *
+			 */
+			bool hasReservation( const void* anOwner) const;
+			/**
+			 *
+			 * @return true if a robot with aRadius at aPosition at aTick keeps clear of all robots but anOwner
+			 */
+			bool isFree(	const void* anOwner,
+							const wxPoint& aPosition,
+							int aRadius,
+							Tick aTick) const;
+			/**
+			 *
+			 * @return true if a robot can stay at aPosition from aTick on
+			 */
+			bool isFreeFrom(	const void* anOwner,
+								const wxPoint& aPosition,
+								int aRadius,
+								Tick aTick) const;
+
+		private:
+			/**
+			 *
+			 */
+			struct Reservation
+			{
+				Tick startTick;
+				std::vector< wxPoint > positions;
+				int radius;
+			};
+			/**
+			 *
+			 */
+			ReservationTable();
+
+			std::chrono::steady_clock::time_point epoch;
+			std::unordered_map< const void*, Reservation > reservations;
+			mutable std::recursive_mutex mutex;
+	}; // class ReservationTable
+} // namespace PathAlgorithm
+#endif // RESERVATIONTABLE_HPP_
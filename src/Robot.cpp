@@ -1,11 +1,14 @@
 #include "Robot.hpp"
 
+#include "ClearanceMap.hpp"
 #include "Client.hpp"
 #include "CommunicationService.hpp"
+#include "CostField.hpp"
 #include "Goal.hpp"
 #include "Logger.hpp"
 #include "MainApplication.hpp"
 #include "MathUtils.hpp"
+#include "PlanningPool.hpp"
 #include "Message.hpp"
 #include "MessageTypes.hpp"
 #include "RobotWorld.hpp"
@@ -16,13 +19,26 @@
 #include "MainFrameWindow.hpp"
 #include "serverConfig.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <ctime>
+#include <limits>
+#include <optional>
 #include <sstream>
 #include <thread>
 
 namespace Model
 {
+	namespace
+	{
+		/**
+		 * The time a search may take before the robot starts driving its best partial route, and the time
+		 * it is resumed for between the steps of drive() after that
+		 */
+		const std::chrono::milliseconds FirstSearchBudget( 50);
+		const std::chrono::milliseconds RefineSearchBudget( 20);
+	} // namespace
 	/**
 	 *
 	 */
@@ -44,7 +60,11 @@ namespace Model
 								size( wxDefaultSize),
 								position( aPosition),
 								front( 0, 0),
+								box( Utils::OrientedBox::fromRectangle( aPosition, wxSize( 0, 0))),
+								heading( 0.0),
 								speed( 0.0),
+								timedRoute(false),
+								routeStartTick(0),
 								acting(false),
 								driving(false),
 								communicating(false),
@@ -52,6 +72,8 @@ namespace Model
 	{
 		// We use the real position for starters, not an estimated position.
 		startPosition = position;
+		planner = &astar;
+		updateFootprint();
 	}
 	/**
 	 *
@@ -70,6 +92,7 @@ namespace Model
 		{
 			stopCommunicating();
 		}
+		PathAlgorithm::ReservationTable::getReservationTable().release( this);
 	}
 	/**
 	 *
@@ -97,6 +120,7 @@ namespace Model
 							bool aNotifyObservers /*= true*/)
 	{
 		size = aSize;
+		updateFootprint();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -109,6 +133,8 @@ namespace Model
 								bool aNotifyObservers /*= true*/)
 	{
 		position = aPosition;
+		updateFootprint();
+		RobotWorld::getRobotWorld().updateIndex( this);
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -128,6 +154,7 @@ namespace Model
 							bool aNotifyObservers /*= true*/)
 	{
 		front = aVector;
+		updateFootprint();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -179,6 +206,13 @@ namespace Model
 		driving = true;
 
 		goal = RobotWorld::getRobotWorld().getGoal( "Goal");
+		if (Application::MainApplication::getSettings().getPathPlanner() == Application::MainSettings::NearestGoalPlanner)
+		{
+			if (GoalPtr nearest = nearestGoal())
+			{
+				goal = nearest;
+			}
+		}
 		calculateRoute(goal);
 
 		drive();
@@ -245,88 +279,8 @@ namespace Model
 	/**
 	 *
 	 */
-	wxRegion Robot::getRegion() const
-	{
-		wxPoint translatedPoints[] = { getFrontRight(), getFrontLeft(), getBackLeft(), getBackRight() };
-		return wxRegion( 4, translatedPoints); // @suppress("Avoid magic numbers")
-	}
-	/**
-	 *
-	 */
-	bool Robot::intersects( const wxRegion& aRegion) const{
-		wxRegion region = expandedRegion();
-		region.Intersect( aRegion);
-		return !region.IsEmpty();
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getFrontLeft() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalFrontLeft( x, y);
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		wxPoint frontLeft( static_cast<int>((originalFrontLeft.x - position.x) * std::cos( angle) - (originalFrontLeft.y - position.y) * std::sin( angle) + position.x),
-						 static_cast<int>((originalFrontLeft.y - position.y) * std::cos( angle) + (originalFrontLeft.x - position.x) * std::sin( angle) + position.y));
-
-		return frontLeft;
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getFrontRight() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalFrontRight( x + size.x, y);
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		wxPoint frontRight( static_cast<int>((originalFrontRight.x - position.x) * std::cos( angle) - (originalFrontRight.y - position.y) * std::sin( angle) + position.x),
-						  static_cast<int>((originalFrontRight.y - position.y) * std::cos( angle) + (originalFrontRight.x - position.x) * std::sin( angle) + position.y));
-
-		return frontRight;
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getBackLeft() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalBackLeft( x, y + size.y);
-
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		wxPoint backLeft( static_cast<int>((originalBackLeft.x - position.x) * std::cos( angle) - (originalBackLeft.y - position.y) * std::sin( angle) + position.x),
-						static_cast<int>((originalBackLeft.y - position.y) * std::cos( angle) + (originalBackLeft.x - position.x) * std::sin( angle) + position.y));
-
-		return backLeft;
-	}
-	/**
-	 *
-	 */
-	wxPoint Robot::getBackRight() const
-	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		wxPoint originalBackRight( x + size.x, y + size.y);
-
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		wxPoint backRight( static_cast<int>((originalBackRight.x - position.x) * std::cos( angle) - (originalBackRight.y - position.y) * std::sin( angle) + position.x),
-						 static_cast<int>((originalBackRight.y - position.y) * std::cos( angle) + (originalBackRight.x - position.x) * std::sin( angle) + position.y));
-
-		return backRight;
+	bool Robot::intersects( const Utils::OrientedBox& aBox) const{
+		return getExpandedBox().intersects( aBox);
 	}
 	/**
 	 *
@@ -335,11 +289,8 @@ namespace Model
 	{
 		//	std::unique_lock<std::recursive_mutex> lock(robotMutex);
 
-		static int update = 0;
-		if ((++update % 200) == 0) // @suppress("Avoid magic numbers")
-		{
-			notifyObservers();
-		}
+		// The AStar search already batches its notifications, see AStar::setNotificationCadence
+		notifyObservers();
 	}
 	/**
 	 *
@@ -520,16 +471,65 @@ namespace Model
 			// We use the real position for starters, not an estimated position.
 			startPosition = position;
 
-			unsigned pathPoint = 0;
-			while (position.x > 0 && position.x < 500 && position.y > 0 && position.y < 500 && pathPoint < path.size()) // @suppress("Avoid magic numbers")
+			// The path is a list of corners, every step the robot drives speed further along the straight
+			// line to the next corner. The route is kept alive here even if a new one is planned meanwhile.
+			PathAlgorithm::CompactPathPtr route = getPath();
+			PathAlgorithm::FlowFieldPtr field = flowField;
+			if (!route)
+			{
+				return;
+			}
+			// The cursor starts anew whenever the route is refined
+			std::optional< PathAlgorithm::CompactPath::Cursor > cursor( route->getCursor());
+			std::size_t reachedCount = cursor->getReachedCount();
+			PathAlgorithm::ReservationTable& reservationTable = PathAlgorithm::ReservationTable::getReservationTable();
+			while (position.x > 0 && position.x < 500 && position.y > 0 && position.y < 500 && // @suppress("Avoid magic numbers")
+				   (field ? field->getDirection( position.x, position.y) != PathAlgorithm::FlowField::NoDirection :
+							timedRoute ? position != route->back() : refinement.active || !cursor->isAtEnd()))
 			{
 				Application::MainFrameWindow::requestRobotLocation();
 
-				// Do the update
-				const PathAlgorithm::Vertex& vertex = path[pathPoint+=static_cast<unsigned int>(speed)];
-				front = BoundedVector( vertex.asPoint(), position);
-				position.x = vertex.x;
-				position.y = vertex.y;
+				// The search of the route goes on while the robot drives its best partial route
+				if (refinement.active)
+				{
+					if (PathAlgorithm::CompactPathPtr refinedRoute = refineRoute( *route, reachedCount))
+					{
+						route = refinedRoute;
+						cursor.emplace( *route);
+						reachedCount = cursor->getReachedCount();
+					}
+				}
+
+				// Do the update, a fast robot may move further than its own length in one step
+				wxPoint previousPosition = position;
+				BoundedVector previousFront = front;
+				std::array< wxPoint, 4 > previousCorners = { frontLeft, frontRight, backRight, backLeft };
+				wxPoint next;
+				if (field)
+				{
+					// With a flow field there is no route: every step follows the directions of the cells.
+					next = field->advance( position, speed);
+				} else if (timedRoute)
+				{
+					// A timed route has the position of every tick, the robot is wherever the clock says it should be.
+					PathAlgorithm::ReservationTable::Tick tick = reservationTable.getCurrentTick() - routeStartTick;
+					next = (*route)[static_cast< std::size_t >( std::max( std::min( tick, static_cast< PathAlgorithm::ReservationTable::Tick >( route->size()) - 1), PathAlgorithm::ReservationTable::Tick( 0)))];
+				} else
+				{
+					next = cursor->advance( speed);
+					if (refinement.active)
+					{
+						followTrail( *route, reachedCount, cursor->getReachedCount());
+					}
+					reachedCount = cursor->getReachedCount();
+				}
+				if (next != position)
+				{
+					front = BoundedVector( next, position);
+				}
+				position = next;
+				updateFootprint();
+				RobotWorld::getRobotWorld().updateIndex( this);
 
 
 				// Stop on arrival or collision
@@ -543,12 +543,18 @@ namespace Model
 				}
 
             }
-            if (wallCollision()) {
+            if (wallCollision( previousPosition, previousCorners)) {
                 Application::Logger::log(
                         __PRETTY_FUNCTION__ + std::string(": wall collision"));
+                // Stop in front of the wall instead of in it or behind it
+                position = previousPosition;
+                front = previousFront;
+                updateFootprint();
+                RobotWorld::getRobotWorld().updateIndex( this);
                 driving = false;
             }
-            if (robotCollision()) {
+            // A timed route keeps clear of the reserved routes of the other robots, there is nothing to evade
+            if (!timedRoute && robotCollision()) {
                 Application::Logger::log(
                         __PRETTY_FUNCTION__ + std::string(": robot collision"));
                 // evade();
@@ -580,6 +586,13 @@ namespace Model
 					break;
 				}
 			} // while
+
+			// A search that is not done yet is abandoned with the route
+			if (refinement.active)
+			{
+				refinement.active = false;
+				stopHandlingNotificationsFor( *planner);
+			}
 		}
 		catch (std::exception& e)
 		{
@@ -596,71 +609,345 @@ namespace Model
 	 *
 	 */
 	void Robot::calculateRoute(WayPointPtr aGoal){
-		path.clear();
+		if (refinement.active)
+		{
+			refinement.active = false;
+			stopHandlingNotificationsFor( *planner);
+		}
+		{
+			std::lock_guard< std::recursive_mutex > lock( robotMutex);
+			path.reset();
+		}
+		flowField.reset();
+		timedRoute = false;
 		if (aGoal)
 		{
 			// Turn off logging if not debugging AStar
 			Application::Logger::setDisable();
 
 			front = BoundedVector( aGoal->getPosition(), position);
-			//handleNotificationsFor( astar);
-			path = astar.search( position, aGoal->getPosition(), size);
-			//stopHandlingNotificationsFor( astar);
+			updateFootprint();
+			Application::MainSettings::PathPlanner pathPlanner = Application::MainApplication::getSettings().getPathPlanner();
+			switch (pathPlanner)
+			{
+				case Application::MainSettings::JumpPointSearchPlanner:
+				{
+					planner = &jumpPointSearch;
+					break;
+				}
+				case Application::MainSettings::HierarchicalPlanner:
+				{
+					planner = &hierarchicalAStar;
+					break;
+				}
+				case Application::MainSettings::DStarLitePlanner:
+				{
+					// The other robots are obstacles, only the ones that moved since the previous route are repaired
+					std::vector< wxPoint > robotPositions;
+					for (RobotPtr robot : RobotWorld::getRobotWorld().getRobots())
+					{
+						if (robot->getObjectId() != getObjectId())
+						{
+							robotPositions.push_back( robot->getPosition());
+						}
+					}
+					dStarLite.setRobotObstacles( robotPositions);
+					planner = &dStarLite;
+					break;
+				}
+				default:
+				{
+					planner = &astar;
+					break;
+				}
+			}
+
+			// Read the version before the search: if the walls change during the search the path is cached as stale
+			unsigned long geometryVersion = RobotWorld::getRobotWorld().getGeometryVersion();
+			int freeRadius = PathAlgorithm::AStar::getFreeRadius( size);
+			// The route of D* Lite also depends on the positions of the other robots, it is not cached but repaired.
+			// The route to a goal along its cost field needs no search, other waypoints are searched with AStar.
+			// A flow field replaces the route to a goal altogether.
+			bool cacheable = pathPlanner == Application::MainSettings::AStarPlanner ||
+							 pathPlanner == Application::MainSettings::JumpPointSearchPlanner ||
+							 pathPlanner == Application::MainSettings::HierarchicalPlanner;
+			bool routed = false;
+			bool searched = false;
+			PathAlgorithm::SearchStats searchStats;
+			if (pathPlanner == Application::MainSettings::NearestGoalPlanner && std::dynamic_pointer_cast< Goal >( aGoal))
+			{
+				routed = PathAlgorithm::CostField::getCostField( aGoal->getPosition(), size)->getPath( position, plannedPath);
+			} else if (pathPlanner == Application::MainSettings::FlowFieldPlanner && std::dynamic_pointer_cast< Goal >( aGoal))
+			{
+				PathAlgorithm::FlowFieldPtr field = PathAlgorithm::FlowField::getFlowField( aGoal->getPosition(), size);
+				if (field->getDirection( position.x, position.y) != PathAlgorithm::FlowField::NoDirection)
+				{
+					flowField = field;
+					plannedPath.clear();
+					routed = true;
+				}
+			} else if (pathPlanner == Application::MainSettings::CooperativePlanner)
+			{
+				// The robots that are not driving a reserved route stay where they are, a reservation of an earlier
+				// route or of an earlier stop is replaced by where they are now
+				PathAlgorithm::ReservationTable& reservationTable = PathAlgorithm::ReservationTable::getReservationTable();
+				for (RobotPtr robot : RobotWorld::getRobotWorld().getRobots())
+				{
+					if (robot.get() != this && (!robot->isDriving() || !robot->hasTimedRoute()))
+					{
+						reservationTable.park( robot.get(), robot->getPosition(), PathAlgorithm::AStar::getFreeRadius( robot->getSize()));
+					}
+				}
+				// Every tick the robot moves one lattice step of speed pixels along each axis it moves along, so a
+				// diagonal step is speed times the square root of 2 pixels long
+				int step = static_cast< int >( std::lround( Application::MainApplication::getSettings().getSpeed()));
+				std::vector< wxPoint > positions;
+				if (cooperativeAStar.plan( this, position, aGoal->getPosition(), size, step > 0 ? step : 5, routeStartTick, positions)) // @suppress("Avoid magic numbers")
+				{
+					plannedPath.clear();
+					for (const wxPoint& aPosition : positions)
+					{
+						plannedPath.emplace_back( aPosition);
+					}
+					timedRoute = true;
+					routed = true;
+				} else
+				{
+					// The route that is searched instead ignores the other robots, they must evade as before
+					reservationTable.release( this);
+				}
+			}
+			if (!routed && (!cacheable || !pathCache.find( position, aGoal->getPosition(), freeRadius, pathPlanner, geometryVersion, plannedPath)))
+			{
+				// The search notifies in batches so it is cheap enough to keep the visualisation on
+				handleNotificationsFor( *planner);
+				// The searches of all robots share a bounded number of threads
+				PathAlgorithm::PlanningPool& planningPool = PathAlgorithm::PlanningPool::getPlanningPool();
+				PathAlgorithm::AStar::SearchStatus searchStatus = PathAlgorithm::AStar::SearchFound;
+				if (planner == &astar || planner == &jumpPointSearch)
+				{
+					// If the search takes longer than its first budget the robot starts driving the best
+					// partial route, drive() resumes the search between its steps
+					searchStatus = planningPool.startSearch( *planner, position, aGoal->getPosition(), size, FirstSearchBudget, plannedPath).get();
+					searchStats = planner->getSearchStats();
+				} else
+				{
+					std::future< PathAlgorithm::Path > route = planningPool.plan( *planner, position, aGoal->getPosition(), size, &searchStats);
+					plannedPath = route.get();
+				}
+
+				if (searchStatus == PathAlgorithm::AStar::SearchSuspended)
+				{
+					refinement.active = true;
+					refinement.start = position;
+					refinement.goal = aGoal->getPosition();
+					refinement.freeRadius = freeRadius;
+					refinement.pathPlanner = cacheable ? pathPlanner : -1;
+					refinement.geometryVersion = geometryVersion;
+					refinement.trail.assign( 1, plannedPath.front());
+				} else
+				{
+					stopHandlingNotificationsFor( *planner);
+					searched = true;
+
+					// Only the corners are kept, the robot drives in straight lines between them
+					planner->smoothPath( plannedPath);
+
+					if (cacheable)
+					{
+						pathCache.insert( position, aGoal->getPosition(), freeRadius, pathPlanner, geometryVersion, plannedPath);
+					}
+				}
+			}
+
+			// Only the points are kept for driving and drawing
+			PathAlgorithm::CompactPathPtr compactPath = std::make_shared< const PathAlgorithm::CompactPath >( plannedPath);
+			{
+				std::lock_guard< std::recursive_mutex > lock( robotMutex);
+				path = compactPath;
+			}
 
 			Application::Logger::setDisable( false);
+
+			if (searched)
+			{
+				Application::Logger::log( "Search: " + searchStats.asString());
+			}
 		}else{
 			Application::Logger::log( __PRETTY_FUNCTION__ + std::string(": no goal set"));
 		}
 	}
+	/**
+	 *
+	 */
+	PathAlgorithm::CompactPathPtr Robot::refineRoute(	const PathAlgorithm::CompactPath& aRoute,
+														std::size_t aReachedCount)
+	{
+		PathAlgorithm::AStar::SearchStatus searchStatus = PathAlgorithm::PlanningPool::getPlanningPool().resumeSearch( *planner, RefineSearchBudget, plannedPath).get();
+		if (searchStatus == PathAlgorithm::AStar::SearchSuspended && aReachedCount < aRoute.size())
+		{
+			return nullptr;
+		}
+
+		PathAlgorithm::Path route;
+		route.emplace_back( position);
+		if (searchStatus == PathAlgorithm::AStar::SearchFailed)
+		{
+			Application::Logger::log( __PRETTY_FUNCTION__ + std::string(": no route"));
+		} else
+		{
+			// Back along the trail to the last cell it shares with the path of the search, then along that path.
+			// Both start at the start of the search.
+			const PathAlgorithm::Path& trail = refinement.trail;
+			std::size_t shared = 1;
+			while (shared < trail.size() && shared < plannedPath.size() && trail[shared].equalPoint( plannedPath[shared]))
+			{
+				++shared;
+			}
+			for (std::size_t i = trail.size(); i >= shared; --i)
+			{
+				route.push_back( trail[i - 1]);
+			}
+			route.insert( route.end(), plannedPath.begin() + static_cast< std::ptrdiff_t >( shared), plannedPath.end());
+
+			// The robot is on its way from the last cell of the trail to the next point of aRoute, if the route
+			// goes on through that point it need not go back to the cell first
+			if (route.size() > 2 && aReachedCount < aRoute.size() && route[2].asPoint() == aRoute[aReachedCount])
+			{
+				route.erase( route.begin() + 1);
+			}
+		}
+
+		if (searchStatus != PathAlgorithm::AStar::SearchSuspended)
+		{
+			refinement.active = false;
+			stopHandlingNotificationsFor( *planner);
+			Application::Logger::log( "Search: " + planner->getSearchStats().asString());
+
+			if (searchStatus == PathAlgorithm::AStar::SearchFound)
+			{
+				// The route is driven from here, the path of the search is cached from its start
+				planner->smoothPath( route);
+				if (refinement.pathPlanner >= 0)
+				{
+					planner->smoothPath( plannedPath);
+					pathCache.insert( refinement.start, refinement.goal, refinement.freeRadius, refinement.pathPlanner, refinement.geometryVersion, plannedPath);
+				}
+			}
+		}
+
+		PathAlgorithm::CompactPathPtr compactPath = std::make_shared< const PathAlgorithm::CompactPath >( route);
+		{
+			std::lock_guard< std::recursive_mutex > lock( robotMutex);
+			path = compactPath;
+		}
+		return compactPath;
+	}
+	/**
+	 *
+	 */
+	void Robot::followTrail(	const PathAlgorithm::CompactPath& aRoute,
+								std::size_t aFrom,
+								std::size_t aTo)
+	{
+		// Towards the start of the search is back along the trail, anything else is further along a branch
+		PathAlgorithm::Path& trail = refinement.trail;
+		for (std::size_t i = aFrom; i < aTo; ++i)
+		{
+			PathAlgorithm::Vertex cell( aRoute[i]);
+			if (trail.size() >= 2 && trail[trail.size() - 2].equalPoint( cell))
+			{
+				trail.pop_back();
+			} else if (!trail.back().equalPoint( cell))
+			{
+				trail.push_back( cell);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	GoalPtr Robot::nearestGoal() const
+	{
+		GoalPtr nearest;
+		double nearestCost = std::numeric_limits< double >::infinity();
+		for (GoalPtr aGoal : RobotWorld::getRobotWorld().getGoals())
+		{
+			double cost = PathAlgorithm::CostField::getCostField( aGoal->getPosition(), size)->getCost( position.x, position.y);
+			if (cost < nearestCost)
+			{
+				nearest = aGoal;
+				nearestCost = cost;
+			}
+		}
+		return nearest;
+	}
 	/**
 	 *
 	 */
 	bool Robot::arrived(GoalPtr aGoal) {
-    if (aGoal && intersectsFinish(aGoal->getRegion())) {
+    if (aGoal && intersectsFinish(aGoal->getBox())) {
         return true;
     }
     return false;
 	}
 
 
-	bool Robot::intersectsFinish(const wxRegion &aRegion) const {
-    	wxRegion region = getRegion();
-    	region.Intersect(aRegion);
-    	return !region.IsEmpty();
+	bool Robot::intersectsFinish(const Utils::OrientedBox& aBox) const {
+    	return getBox().intersects( aBox);
 	}
 
 	/**
 	 *
 	 */
-	bool Robot::wallCollision()
+	bool Robot::wallCollision(	const wxPoint& aPreviousPosition,
+								const std::array< wxPoint, 4 >& aPreviousCorners)
     {
-        wxPoint frontLeft = getFrontLeft();
-        wxPoint frontRight = getFrontRight();
-        wxPoint backLeft = getBackLeft();
-        wxPoint backRight = getBackRight();
+        // Everything the robot swept over is within half its diagonal and half its move of the middle of the move
+        wxPoint middle( (aPreviousPosition.x + position.x) / 2, (aPreviousPosition.y + position.y) / 2);
+        int halfMove = static_cast< int >( std::ceil( std::hypot( position.x - aPreviousPosition.x, position.y - aPreviousPosition.y) / 2.0)) + 1;
 
-        const std::vector< WallPtr >& walls = RobotWorld::getRobotWorld().getWalls();
-        for (WallPtr wall : walls)
+        // Far enough from every wall for any rotation of the robot, the free radius is at least half its
+        // diagonal and a wall may be up to one cell closer than its rasterized cells
+        if (PathAlgorithm::ClearanceMap::getClearanceMap()->isFree( middle.x, middle.y, PathAlgorithm::AStar::getFreeRadius( size) + 1 + halfMove))
         {
-            if (Utils::Shape2DUtils::intersect( frontLeft, frontRight, wall->getPoint1(), wall->getPoint2())     ||
-                Utils::Shape2DUtils::intersect( frontLeft, backLeft, wall->getPoint1(), wall->getPoint2())        ||
-                Utils::Shape2DUtils::intersect( frontRight, backRight, wall->getPoint1(), wall->getPoint2()))
-            {
-                Application::Logger::log("CollisionWithWall");
-                return true;
-            }
+            return false;
+        }
+
+        // Only the walls around the move can touch it
+        int reach = static_cast< int >( std::ceil( std::hypot( size.x, size.y) / 2.0)) + 1 + halfMove;
+        nearWalls.clear();
+        for (WallPtr wall : RobotWorld::getRobotWorld().getWallsNear( middle, reach))
+        {
+            nearWalls.add( wall->getPoint1(), wall->getPoint2());
         }
 
-        return false;
+        // The swept footprint is the convex hull of the footprints of both poses. The sides of the hull against
+        // all those walls at once, a wall that crosses none of them may still lie inside the hull
+        wxPoint cornerPoints[] = { aPreviousCorners[0], aPreviousCorners[1], aPreviousCorners[2], aPreviousCorners[3], frontLeft, frontRight, backRight, backLeft };
+        wxPoint hull[8];
+        int hullSize = Utils::Shape2DUtils::getConvexHull( cornerPoints, 8, hull);
+        bool collision = Utils::Shape2DUtils::intersect( hull, hullSize, nearWalls, wallHitMasks);
+        for (std::size_t i = 0; !collision && i < nearWalls.size(); ++i)
+        {
+            collision = Utils::Shape2DUtils::isInsidePolygon( hull, hullSize, nearWalls.getStartPoint( i));
+        }
+        if (collision)
+        {
+            Application::Logger::log("CollisionWithWall");
+        }
+        return collision;
     }
 
     bool Robot::robotCollision() {
-    const std::vector<RobotPtr> &robots = RobotWorld::getRobotWorld().getRobots();
-    for (RobotPtr robot : robots) {
+    // The hit region of a robot reaches twice its diagonal from its position, the expanded region of this
+    // robot reaches less than that; robots of about the same size further away can not be hit
+    int reach = static_cast< int >( std::ceil( 4.0 * std::hypot( size.x, size.y))) + 1;
+    for (RobotPtr robot : RobotWorld::getRobotWorld().getRobotsNear( position, reach)) {
         if (getObjectId() == robot->getObjectId()) {
             continue;
         }
-        if (intersects(robot->hitRegion())) {
+        if (intersects(robot->getHitBox())) {
             Application::Logger::log("CollisionWithRobot");
 			evade();
             return true;
@@ -695,12 +982,8 @@ void Robot::evade() {
 
 double Robot::angleCollision() {
     double angle = 0;
-    const std::vector<RobotPtr> &robots =
-            RobotWorld::getRobotWorld().getRobots();
-    for (RobotPtr robot : robots) {
-        if (getObjectId() == robot->getObjectId()) {
-            continue;
-        }
+    // The robot that is evaded is the nearest one
+    if (RobotPtr robot = RobotWorld::getRobotWorld().getNearestRobot( position, this)) {
             angle = Utils::Shape2DUtils::getAngle(this->position, robot->position);
             angle = Utils::MathUtils::toDegrees(angle);
             double currentAngle = Utils::Shape2DUtils::getAngle(front);
@@ -728,45 +1011,18 @@ void Robot::turnAround() {
     restartDriving();
 }
 
-wxRegion Robot::expandedRegion() const {
-    int leftX = 0;
-    int leftY = 0;
-    int rightX = 0;
-    int rightY = 0;
-    if (getFrontRight().x >= getBackRight().x) {
-        rightX = getFrontRight().x + (getFrontRight().x - getBackRight().x);
-    } else {
-        rightX = getFrontRight().x + (getBackRight().x - getFrontRight().x);
-    }
-    if (getFrontRight().y >= getBackRight().y) {
-        rightY = getFrontRight().y + (getFrontRight().y - getBackRight().y);
-    } else {
-        rightY = getFrontRight().y + (getBackRight().y - getFrontRight().y);
-    }
-
-    if (getFrontLeft().x >= getBackLeft().x) {
-        leftX = getFrontLeft().x + (getFrontLeft().x - getBackLeft().x);
-    } else {
-        leftX = getFrontLeft().x + (getBackLeft().x - getFrontLeft().x);
-    }
-    if (getFrontLeft().y >= getBackLeft().y) {
-        leftY = getFrontLeft().y + (getFrontLeft().y - getBackLeft().y);
-    } else {
-        leftY = getFrontLeft().y + (getBackLeft().y - getFrontLeft().y);
-    }
-
-    wxPoint newFrontLeft(leftX, leftY);
-    wxPoint newFrontRight(rightX, rightY);
-
-    wxPoint translatedPoints[] = { newFrontRight, newFrontLeft, getBackLeft(),
-            getBackRight() };
-
-    Application::Logger::log(Utils::Shape2DUtils::asString(newFrontLeft));
-    return wxRegion(4, translatedPoints);
+Utils::OrientedBox Robot::getExpandedBox() const {
+    // The footprint with a copy of itself in front of it
+    return Utils::OrientedBox::fromAxis( box.getCentreX() + box.getAxisX() * box.getHalfLength(),
+                                         box.getCentreY() + box.getAxisY() * box.getHalfLength(),
+                                         box.getAxisX(),
+                                         box.getAxisY(),
+                                         2.0 * box.getHalfLength(),
+                                         box.getHalfWidth());
 }
 
 bool Robot::arrived(WayPointPtr tempGoal) {
-    if (tempGoal && intersects(tempGoal->getRegion())) {
+    if (tempGoal && intersects(tempGoal->getBox())) {
         return true;
     }
     return false;
@@ -778,20 +1034,34 @@ void Robot::restartDriving() {
     drive();
 }
 
-wxRegion Robot::hitRegion() const {
-    // x and y are pointing to top left now
-    int x = position.x - (size.x * 2);
-    int y = position.y - (size.y * 2);
-
-    wxPoint originalUpperLeft(x, y);
-    wxPoint originalUpperRight(x + size.x * 4, y);
-    wxPoint originalBottomLeft(x, y + size.y * 4);
-    wxPoint originalBottomRight(x + size.x * 4, y + size.y * 4);
-
-    wxPoint originalPoints[] = { originalUpperRight, originalUpperLeft,
-            originalBottomLeft, originalBottomRight };
+Utils::OrientedBox Robot::getHitBox() const {
+    return Utils::OrientedBox::fromRectangle( position, wxSize( size.x * 4, size.y * 4));
+}
 
-    return wxRegion(4, originalPoints);
+void Robot::updateFootprint() {
+    heading = Utils::Shape2DUtils::getAngle( front);
+    box = Utils::OrientedBox::fromAxis( position.x, position.y, std::cos( heading), std::sin( heading), size.y / 2.0, size.x / 2.0);
+
+    // The corners of the upright robot, x and y are pointing to top left, rotated around the position
+    int x = position.x - (size.x / 2);
+    int y = position.y - (size.y / 2);
+    double angle = heading + 0.5 * Utils::PI;
+    double cosAngle = std::cos( angle);
+    double sinAngle = std::sin( angle);
+    auto rotate = [this, cosAngle, sinAngle]( const wxPoint& anOriginal) {
+        return wxPoint( static_cast<int>((anOriginal.x - position.x) * cosAngle - (anOriginal.y - position.y) * sinAngle + position.x),
+                        static_cast<int>((anOriginal.y - position.y) * cosAngle + (anOriginal.x - position.x) * sinAngle + position.y));
+    };
+    frontLeft = rotate( wxPoint( x, y));
+    frontRight = rotate( wxPoint( x + size.x, y));
+    backLeft = rotate( wxPoint( x, y + size.y));
+    backRight = rotate( wxPoint( x + size.x, y + size.y));
+
+    int left = std::min( std::min( frontLeft.x, frontRight.x), std::min( backLeft.x, backRight.x));
+    int top = std::min( std::min( frontLeft.y, frontRight.y), std::min( backLeft.y, backRight.y));
+    int right = std::max( std::max( frontLeft.x, frontRight.x), std::max( backLeft.x, backRight.x));
+    int bottom = std::max( std::max( frontLeft.y, frontRight.y), std::max( backLeft.y, backRight.y));
+    boundingBox = wxRect( left, top, right - left + 1, bottom - top + 1);
 }
 
 } // namespace Model
@@ -5,20 +5,32 @@
 
 #include "AStar.hpp"
 #include "BoundedVector.hpp"
+#include "CompactPath.hpp"
+#include "CooperativeAStar.hpp"
+#include "DStarLite.hpp"
+#include "FlowField.hpp"
+#include "HierarchicalAStar.hpp"
+#include "JumpPointSearch.hpp"
 #include "Message.hpp"
 #include "MessageHandler.hpp"
 #include "ModelObject.hpp"
 #include "Observer.hpp"
+#include "OrientedBox.hpp"
+#include "PathCache.hpp"
 #include "Point.hpp"
 #include "Region.hpp"
+#include "SegmentList.hpp"
 #include "Size.hpp"
 #include "WayPoint.hpp"
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace Messaging
 {
@@ -140,6 +152,14 @@ namespace Model
 			{
 				return driving;
 			}
+			/**
+			 *
+			 * @return true if the route of the robot is timed, i.e. reserved in the ReservationTable
+			 */
+			bool hasTimedRoute() const
+			{
+				return timedRoute;
+			}
 			/**
 			 *
 			 */
@@ -169,31 +189,63 @@ namespace Model
 			 */
 			void stopCommunicating();
 			/**
-			 *
+			 * The footprint of the robot: the width of its size across its front and the height along it
 			 */
-			wxRegion getRegion() const;
+			Utils::OrientedBox getBox() const
+			{
+				return box;
+			}
+			/**
+			 * The smallest upright rectangle around the corners of the robot
+			 */
+			wxRect getBoundingBox() const
+			{
+				return boundingBox;
+			}
+			/**
+			 * The angle of the front in radians, see Utils::Shape2DUtils::getAngle( const BoundedVector&)
+			 */
+			double getHeading() const
+			{
+				return heading;
+			}
 			/**
 			 *
+			 * @return true if the footprint, stretched forward by the length of the robot, overlaps aBox
 			 */
-			bool intersects( const wxRegion& aRegion) const;
+			bool intersects( const Utils::OrientedBox& aBox) const;
 			/**
 			 *
 			 */
-			wxPoint getFrontLeft() const;
-
-			wxRegion hitRegion() const;
+			wxPoint getFrontLeft() const
+			{
+				return frontLeft;
+			}
+			/**
+			 * The area around the robot that the other robots keep out of, twice its size in every direction
+			 */
+			Utils::OrientedBox getHitBox() const;
 			/**
 			 *
 			 */
-			wxPoint getFrontRight() const;
+			wxPoint getFrontRight() const
+			{
+				return frontRight;
+			}
 			/**
 			 *
 			 */
-			wxPoint getBackLeft() const;
+			wxPoint getBackLeft() const
+			{
+				return backLeft;
+			}
 			/**
 			 *
 			 */
-			wxPoint getBackRight() const;
+			wxPoint getBackRight() const
+			{
+				return backRight;
+			}
 			/**
 			 * @name Observer functions
 			 */
@@ -210,13 +262,14 @@ namespace Model
 			 */
 			PathAlgorithm::OpenSet getOpenSet() const
 			{
-				return astar.getOpenSet();
+				return planner->getOpenSet();
 			}
 			/**
-			 *
+			 * The route as it is driven, shared and never changed, or nullptr if there is none
 			 */
-			PathAlgorithm::Path getPath() const
+			PathAlgorithm::CompactPathPtr getPath() const
 			{
+				std::lock_guard< std::recursive_mutex > lock( robotMutex);
 				return path;
 			}
 			/**
@@ -276,20 +329,48 @@ namespace Model
              *
              */
             bool arrived( GoalPtr aGoal);
-            bool intersectsFinish(const wxRegion &aRegion) const;
+            /**
+             * @return the goal with the cheapest route from the current position, nullptr if none can be reached
+             */
+            GoalPtr nearestGoal() const;
+            bool intersectsFinish(const Utils::OrientedBox& aBox) const;
             bool arrived(WayPointPtr tempGoal);
 
-            bool wallCollision();
+            /**
+             * @return true if the footprint hits a wall anywhere on its way from the previous pose, with its
+             * position aPreviousPosition and its corners aPreviousCorners, to the current one
+             */
+            bool wallCollision(	const wxPoint& aPreviousPosition,
+								const std::array< wxPoint, 4 >& aPreviousCorners);
             bool robotCollision();
             void evade();
             double angleCollision();
             void turnAround();
-            wxRegion expandedRegion() const;
+            Utils::OrientedBox getExpandedBox() const;
+            /**
+             * Resumes the search of the route for one step of its budget. The robot reached aReachedCount points
+             * of aRoute, the route it drives now.
+             *
+             * @return the route from the current position if the search is done or if the robot reached the end
+             * of aRoute, nullptr if it keeps driving aRoute
+             */
+            PathAlgorithm::CompactPathPtr refineRoute(	const PathAlgorithm::CompactPath& aRoute,
+														std::size_t aReachedCount);
+            /**
+             * Keeps the trail of the search up to date with the points from aFrom up to aTo of aRoute that the robot reached
+             */
+            void followTrail(	const PathAlgorithm::CompactPath& aRoute,
+								std::size_t aFrom,
+								std::size_t aTo);
             /**
              *
              */
             bool collision(); //Depreciated
 		private:
+			/**
+			 * Recomputes the footprint below, must be called whenever the size, the position or the front changes
+			 */
+			void updateFootprint();
 			/**
 			 *
 			 */
@@ -306,6 +387,17 @@ namespace Model
 			 *
 			 */
 			BoundedVector front;
+			/**
+			 * The footprint in the current pose, computed once by updateFootprint() so that the
+			 * collision tests and the drawing of every tick only read it
+			 */
+			wxPoint frontLeft;
+			wxPoint frontRight;
+			wxPoint backLeft;
+			wxPoint backRight;
+			Utils::OrientedBox box;
+			wxRect boundingBox;
+			double heading;
 			/**
 			 *
 			 */
@@ -324,7 +416,66 @@ namespace Model
 			/**
 			 *
 			 */
-			PathAlgorithm::Path path;
+			PathAlgorithm::JumpPointSearch jumpPointSearch;
+			/**
+			 *
+			 */
+			PathAlgorithm::HierarchicalAStar hierarchicalAStar;
+			/**
+			 * Keeps its search state between the routes to the same goal, e.g. when evading
+			 */
+			PathAlgorithm::DStarLite dStarLite;
+			/**
+			 * The path planner of the last route, one of the above
+			 */
+			PathAlgorithm::AStar* planner;
+			/**
+			 * The routes of the previous runs, as long as the walls do not change
+			 */
+			PathAlgorithm::PathCache pathCache;
+			/**
+			 * The route as the planner or the cache wrote it, kept to reuse its storage
+			 */
+			PathAlgorithm::Path plannedPath;
+			/**
+			 *
+			 */
+			PathAlgorithm::CompactPathPtr path;
+			/**
+			 * The directions to the goal if the robot follows a flow field instead of a path
+			 */
+			PathAlgorithm::FlowFieldPtr flowField;
+			/**
+			 * The search of the route that is resumed between the steps of drive() while the robot already
+			 * drives the best partial route of the search so far
+			 */
+			struct Refinement
+			{
+				bool active = false;
+				/**
+				 * What the route is cached under when the search is done
+				 */
+				wxPoint start;
+				wxPoint goal;
+				int freeRadius = 0;
+				int pathPlanner = 0;
+				unsigned long geometryVersion = 0;
+				/**
+				 * The cells of the search from its start to the last one the robot reached. The robot only
+				 * drives along the paths of the search, so this is always a branch of the search tree.
+				 */
+				PathAlgorithm::Path trail;
+			};
+			Refinement refinement;
+			/**
+			 * Plans routes in space and time around the routes the other robots reserved
+			 */
+			PathAlgorithm::CooperativeAStar cooperativeAStar;
+			/**
+			 * If the route is timed it has a position for every tick from routeStartTick on
+			 */
+			bool timedRoute;
+			PathAlgorithm::ReservationTable::Tick routeStartTick;
 			/**
 			 *
 			 */
@@ -339,6 +490,11 @@ namespace Model
 			bool communicating;
 
 			bool tempPointActive;
+			/**
+			 * The walls around the robot and which of them its sides hit, kept to reuse the storage every tick
+			 */
+			Utils::SegmentList nearWalls;
+			std::vector< std::uint32_t > wallHitMasks;
 			/**
 			 *
 			 */
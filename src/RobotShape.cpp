@@ -95,6 +95,10 @@ namespace View
 	 */
 	bool RobotShape::occupies( const wxPoint& aPoint) const
 	{
+		if (!getRobot()->getBoundingBox().Contains( aPoint))
+		{
+			return false;
+		}
 		wxPoint cornerPoints[] = { getRobot()->getFrontRight(), getRobot()->getFrontLeft(), getRobot()->getBackLeft(), getRobot()->getBackRight() };
 		return Utils::Shape2DUtils::isInsidePolygon( cornerPoints, 4, aPoint);
 	}
@@ -189,13 +193,16 @@ namespace View
 	 */
 	void RobotShape::drawPath( wxDC& dc)
 	{
-		PathAlgorithm::Path path = getRobot()->getPath();
-		if (path.size() != 0)
+		// Shared with the robot, not copied
+		PathAlgorithm::CompactPathPtr path = getRobot()->getPath();
+		if (path && !path->empty())
 		{
+			// The path only holds the corners, the robot drives in straight lines between them
 			dc.SetPen( wxPen(  "BLACK", borderWidth, wxPENSTYLE_SOLID));
-			for (const PathAlgorithm::Vertex &vertex : path)
+			dc.DrawPoint( path->front());
+			for (PathAlgorithm::CompactPath::const_iterator i = path->begin() + 1; i != path->end(); ++i)
 			{
-				dc.DrawPoint( vertex.asPoint());
+				dc.DrawLine( i[-1], *i);
 			}
 		}
 	}
@@ -225,7 +232,7 @@ namespace View
 		dc.SetPen( wxPen( "PALE GREEN", borderWidth + 2, wxPENSTYLE_SOLID));
 		dc.DrawPoint( cornerPoints[3]);
 
-		double angle = Utils::Shape2DUtils::getAngle( getRobot()->getFront());
+		double angle = getRobot()->getHeading();
 
 		// Draw the nose
 		dc.SetPen( wxPen(  "BLACK", 1, wxPENSTYLE_SOLID));
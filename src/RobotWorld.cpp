@@ -28,6 +28,7 @@ namespace Model
 	{
 		RobotPtr robot = std::make_shared<Robot>( aName, aPosition);
 		robots.push_back( robot);
+		spatialIndex.insert( robot);
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -43,6 +44,7 @@ namespace Model
 	{
 		WayPointPtr wayPoint(new WayPoint( aName, aPosition));
 		wayPoints.push_back( wayPoint);
+		spatialIndex.insert( wayPoint);
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -58,6 +60,7 @@ namespace Model
 	{
 		GoalPtr goal = std::make_shared<Goal>( aName, aPosition);
 		goals.push_back( goal);
+		spatialIndex.insert( WayPointPtr( goal));
 		if (aNotifyObservers == true){
 			notifyObservers();
 		}
@@ -72,6 +75,8 @@ namespace Model
 	{
 		WallPtr wall = std::make_shared<Wall>( aPoint1, aPoint2);
 		walls.push_back( wall);
+		spatialIndex.insert( wall);
+		invalidateGeometry();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -90,6 +95,7 @@ namespace Model
 							   });
 		if (i != robots.end())
 		{
+			spatialIndex.remove( i->get());
 			robots.erase( i);
 			if (aNotifyObservers == true)
 			{
@@ -109,6 +115,7 @@ namespace Model
 							   });
 		if (i != wayPoints.end())
 		{
+			spatialIndex.remove( i->get());
 			wayPoints.erase( i);
 			if (aNotifyObservers == true)
 			{
@@ -128,6 +135,7 @@ namespace Model
 							   });
 		if (i != goals.end())
 		{
+			spatialIndex.remove( static_cast< const WayPoint* >( i->get()));
 			goals.erase( i);
 
 			if (aNotifyObservers == true)
@@ -150,7 +158,9 @@ namespace Model
 							   });
 		if (i != walls.end())
 		{
+			spatialIndex.remove( i->get());
 			walls.erase( i);
+			invalidateGeometry();
 
 			if (aNotifyObservers == true)
 			{
@@ -315,6 +325,8 @@ namespace Model
 		wayPoints.clear();
 		goals.clear();
 		walls.clear();
+		spatialIndex.clear();
+		invalidateGeometry();
 
 		if (aNotifyObservers)
 		{
@@ -375,6 +387,26 @@ namespace Model
 																aWall->getObjectId()) == aKeepObjects.end();
 											}),
 							walls.end());
+			invalidateGeometry();
+		}
+
+		// Only the objects that are kept are indexed again
+		spatialIndex.clear();
+		for (RobotPtr robot : robots)
+		{
+			spatialIndex.insert( robot);
+		}
+		for (WayPointPtr wayPoint : wayPoints)
+		{
+			spatialIndex.insert( wayPoint);
+		}
+		for (GoalPtr goal : goals)
+		{
+			spatialIndex.insert( WayPointPtr( goal));
+		}
+		for (WallPtr wall : walls)
+		{
+			spatialIndex.insert( wall);
 		}
 
 		if (aNotifyObservers)
@@ -421,10 +453,15 @@ namespace Model
 	void RobotWorld::addRobot(RobotPtr robot){
 		//Add robot to the robots vector:
 		robots.push_back(robot);
+		spatialIndex.insert( robot);
 		notifyObservers();
 	}
 
 	void RobotWorld::clearWaypoints(){
+		for (WayPointPtr wayPoint : wayPoints)
+		{
+			spatialIndex.remove( wayPoint.get());
+		}
 		wayPoints.clear();
 		notifyObservers();
 	}
@@ -4,8 +4,10 @@
 #include "Config.hpp"
 
 #include "ModelObject.hpp"
+#include "SpatialIndex.hpp"
 #include "Widgets.hpp"
 
+#include <atomic>
 #include <vector>
 
 namespace Model
@@ -108,6 +110,81 @@ namespace Model
 			void addRobot(RobotPtr aRobot);
 
             void clearWaypoints();
+			/**
+			 * The geometry version increases whenever a wall is added, deleted or moved. Anything that is derived
+			 * from the walls, e.g. an OccupancyGrid, only has to be updated if the version changed.
+			 */
+			unsigned long getGeometryVersion() const
+			{
+				return geometryVersion;
+			}
+			/**
+			 * Called by a Wall if one of its points changed, whether or not the Wall notifies its observers
+			 */
+			void invalidateGeometry()
+			{
+				++geometryVersion;
+			}
+			/**
+			 * Called by a Robot, WayPoint (or Goal) or Wall whose position changed, keeps the spatial index up to date
+			 */
+			void updateIndex( const Robot* aRobot)
+			{
+				spatialIndex.update( aRobot);
+			}
+			void updateIndex( const WayPoint* aWayPoint)
+			{
+				spatialIndex.update( aWayPoint);
+			}
+			void updateIndex( const Wall* aWall)
+			{
+				spatialIndex.update( aWall);
+			}
+			/**
+			 *
+			 * @return the robots whose position is at most aRadius from aPoint
+			 */
+			std::vector< RobotPtr > getRobotsNear(	const wxPoint& aPoint,
+													int aRadius) const
+			{
+				return spatialIndex.findRobots( aPoint, aRadius);
+			}
+			/**
+			 *
+			 * @return the robot closest to aPoint other than anExcluded, nullptr if there is none
+			 */
+			RobotPtr getNearestRobot(	const wxPoint& aPoint,
+										const Robot* anExcluded = nullptr) const
+			{
+				return spatialIndex.findNearestRobot( aPoint, anExcluded);
+			}
+			/**
+			 *
+			 * @return the waypoints and goals whose position is at most aRadius from aPoint
+			 */
+			std::vector< WayPointPtr > getWayPointsNear(	const wxPoint& aPoint,
+															int aRadius) const
+			{
+				return spatialIndex.findWayPoints( aPoint, aRadius);
+			}
+			/**
+			 *
+			 * @return the waypoint or goal closest to aPoint, nullptr if there is none
+			 */
+			WayPointPtr getNearestWayPoint( const wxPoint& aPoint) const
+			{
+				return spatialIndex.findNearestWayPoint( aPoint);
+			}
+			/**
+			 *
+			 * @return the walls that may come within aRadius of aPoint: those whose bounding box overlaps the square
+			 * of aRadius around it
+			 */
+			std::vector< WallPtr > getWallsNear(	const wxPoint& aPoint,
+													int aRadius) const
+			{
+				return spatialIndex.findWalls( aPoint, aRadius);
+			}
 
         protected:
 			RobotWorld() = default;
@@ -121,6 +198,14 @@ namespace Model
 			mutable std::vector< WayPointPtr > wayPoints;
 			mutable std::vector< GoalPtr > goals;
 			mutable std::vector< WallPtr > walls;
+			/**
+			 *
+			 */
+			std::atomic< unsigned long > geometryVersion{ 0 };
+			/**
+			 * All robots, waypoints, goals and walls by their position
+			 */
+			SpatialIndex spatialIndex;
 	};
 } // namespace Model
 #endif // ROBOTWORLD_HPP_
@@ -0,0 +1,174 @@
+#include "SearchGrid.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	SearchGrid::SearchGrid() :
+		left( 0),
+		top( 0),
+		width( 0),
+		height( 0),
+		closedCount( 0),
+		predecessorCount( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	void SearchGrid::reset(	int aLeft,
+							int aTop,
+							int aWidth,
+							int aHeight)
+	{
+		left = aLeft;
+		top = aTop;
+		width = std::max( aWidth, 0);
+		height = std::max( aHeight, 0);
+
+		std::size_t cellCount = static_cast< std::size_t >( width) * static_cast< std::size_t >( height);
+
+		// assign() reuses the capacity of the previous searches
+		closed.assign( (cellCount + 63) / 64, 0);
+		predecessors.assign( cellCount, NoCell);
+		costs.assign( cellCount, std::numeric_limits< double >::infinity());
+
+		closedCount = 0;
+		predecessorCount = 0;
+	}
+	/**
+	 *
+	 */
+	Vertex SearchGrid::cellVertex( std::int32_t aCell) const
+	{
+		Vertex vertex( cellX( aCell), cellY( aCell));
+		vertex.actualCost = getCost( aCell);
+		return vertex;
+	}
+	/**
+	 *
+	 */
+	void SearchGrid::setClosed(	std::int32_t aCell,
+								bool aClosed /*= true*/)
+	{
+		if (isClosed( aCell) == aClosed)
+		{
+			return;
+		}
+		std::uint64_t mask = std::uint64_t( 1) << (aCell & 63);
+		if (aClosed)
+		{
+			closed[static_cast< std::size_t >( aCell) >> 6] |= mask;
+			++closedCount;
+		} else
+		{
+			closed[static_cast< std::size_t >( aCell) >> 6] &= ~mask;
+			--closedCount;
+		}
+	}
+	/**
+	 *
+	 */
+	void SearchGrid::setPredecessor(	std::int32_t aCell,
+										std::int32_t aPredecessor)
+	{
+		std::int32_t& predecessor = predecessors[static_cast< std::size_t >( aCell)];
+		if (predecessor == NoCell && aPredecessor != NoCell)
+		{
+			++predecessorCount;
+		} else if (predecessor != NoCell && aPredecessor == NoCell)
+		{
+			--predecessorCount;
+		}
+		predecessor = aPredecessor;
+	}
+	/**
+	 *
+	 */
+	ClosedSetView::const_iterator::const_iterator(	const SearchGrid* aGrid,
+													std::int32_t aCell) :
+		grid( aGrid),
+		cell( aCell)
+	{
+		skip();
+	}
+	/**
+	 *
+	 */
+	ClosedSetView::const_iterator& ClosedSetView::const_iterator::operator++()
+	{
+		++cell;
+		skip();
+		return *this;
+	}
+	/**
+	 *
+	 */
+	void ClosedSetView::const_iterator::skip()
+	{
+		while (cell < grid->getCellCount() && !grid->isClosed( cell))
+		{
+			++cell;
+		}
+	}
+	/**
+	 *
+	 */
+	bool ClosedSetView::contains( const Vertex& aVertex) const
+	{
+		std::int32_t cell = grid->cellIndex( aVertex);
+		return cell != SearchGrid::NoCell && grid->isClosed( cell);
+	}
+	/**
+	 *
+	 */
+	PredecessorMapView::const_iterator::const_iterator(	const SearchGrid* aGrid,
+															std::int32_t aCell) :
+		grid( aGrid),
+		cell( aCell)
+	{
+		skip();
+	}
+	/**
+	 *
+	 */
+	PredecessorMapView::const_iterator& PredecessorMapView::const_iterator::operator++()
+	{
+		++cell;
+		skip();
+		return *this;
+	}
+	/**
+	 *
+	 */
+	void PredecessorMapView::const_iterator::skip()
+	{
+		while (cell < grid->getCellCount() && grid->getPredecessor( cell) == SearchGrid::NoCell)
+		{
+			++cell;
+		}
+	}
+	/**
+	 *
+	 */
+	bool PredecessorMapView::contains( const Vertex& aVertex) const
+	{
+		std::int32_t cell = grid->cellIndex( aVertex);
+		return cell != SearchGrid::NoCell && grid->getPredecessor( cell) != SearchGrid::NoCell;
+	}
+	/**
+	 *
+	 */
+	Vertex PredecessorMapView::at( const Vertex& aVertex) const
+	{
+		if (!contains( aVertex))
+		{
+			throw std::out_of_range( "PredecessorMapView::at: no predecessor");
+		}
+		return grid->cellVertex( grid->getPredecessor( grid->cellIndex( aVertex)));
+	}
+} // namespace PathAlgorithm
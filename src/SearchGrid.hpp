@@ -0,0 +1,366 @@
+#ifndef SEARCHGRID_HPP_
+#define SEARCHGRID_HPP_
+
+#include "Config.hpp"
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace PathAlgorithm
+{
+	/**
+	 * The SearchGrid is the dense, cell indexed bookkeeping of a search over a bounded integer grid:
+	 * a bitset for the closed cells, the index of the predecessor cell and the actual cost from the start.
+	 *
+	 * The storage is kept between searches and only grows, reset() just clears it.
+	 */
+	class SearchGrid
+	{
+		public:
+			/**
+			 * The cell index of "no cell", e.g. the predecessor of the start cell
+			 */
+			static constexpr std::int32_t NoCell = -1;
+			/**
+			 *
+			 */
+			SearchGrid();
+			/**
+			 * Sets the bounds for the next search and clears all cells
+			 */
+			void reset(	int aLeft,
+						int aTop,
+						int aWidth,
+						int aHeight);
+			/**
+			 *
+			 */
+			int getLeft() const
+			{
+				return left;
+			}
+			/**
+			 *
+			 */
+			int getTop() const
+			{
+				return top;
+			}
+			/**
+			 *
+			 */
+			int getWidth() const
+			{
+				return width;
+			}
+			/**
+			 *
+			 */
+			int getHeight() const
+			{
+				return height;
+			}
+			/**
+			 *
+			 */
+			std::int32_t getCellCount() const
+			{
+				return width * height;
+			}
+			/**
+			 *
+			 * @return the index of the cell at (anX,anY) or NoCell if the point is outside the grid
+			 */
+			std::int32_t cellIndex(	int anX,
+									int anY) const
+			{
+				int column = anX - left;
+				int row = anY - top;
+				if (column < 0 || column >= width || row < 0 || row >= height)
+				{
+					return NoCell;
+				}
+				return row * width + column;
+			}
+			/**
+			 *
+			 */
+			std::int32_t cellIndex( const Vertex& aVertex) const
+			{
+				return cellIndex( aVertex.x, aVertex.y);
+			}
+			/**
+			 *
+			 */
+			int cellX( std::int32_t aCell) const
+			{
+				return left + aCell % width;
+			}
+			/**
+			 *
+			 */
+			int cellY( std::int32_t aCell) const
+			{
+				return top + aCell / width;
+			}
+			/**
+			 *
+			 * @return the Vertex of the cell with its actual cost
+			 */
+			Vertex cellVertex( std::int32_t aCell) const;
+			/**
+			 *
+			 */
+			bool isClosed( std::int32_t aCell) const
+			{
+				return (closed[static_cast< std::size_t >( aCell) >> 6] >> (aCell & 63)) & 1U;
+			}
+			/**
+			 *
+			 */
+			void setClosed(	std::int32_t aCell,
+							bool aClosed = true);
+			/**
+			 *
+			 */
+			std::size_t getClosedCount() const
+			{
+				return closedCount;
+			}
+			/**
+			 *
+			 */
+			std::int32_t getPredecessor( std::int32_t aCell) const
+			{
+				return predecessors[static_cast< std::size_t >( aCell)];
+			}
+			/**
+			 *
+			 */
+			void setPredecessor(	std::int32_t aCell,
+									std::int32_t aPredecessor);
+			/**
+			 *
+			 */
+			std::size_t getPredecessorCount() const
+			{
+				return predecessorCount;
+			}
+			/**
+			 *
+			 * @return the actual cost from the start or infinity if the cell was not reached (yet)
+			 */
+			double getCost( std::int32_t aCell) const
+			{
+				return costs[static_cast< std::size_t >( aCell)];
+			}
+			/**
+			 *
+			 */
+			void setCost(	std::int32_t aCell,
+							double aCost)
+			{
+				costs[static_cast< std::size_t >( aCell)] = aCost;
+			}
+
+		private:
+			int left;
+			int top;
+			int width;
+			int height;
+			/**
+			 * One bit per cell
+			 */
+			std::vector< std::uint64_t > closed;
+			std::size_t closedCount;
+			/**
+			 * The cell index of the predecessor or NoCell
+			 */
+			std::vector< std::int32_t > predecessors;
+			std::size_t predecessorCount;
+			/**
+			 *
+			 */
+			std::vector< double > costs;
+	}; // class SearchGrid
+
+	/**
+	 * A read-only view on the closed cells of a SearchGrid. It is only valid until the next search.
+	 */
+	class ClosedSetView
+	{
+		public:
+			/**
+			 *
+			 */
+			class const_iterator
+			{
+				public:
+					typedef std::forward_iterator_tag iterator_category;
+					typedef Vertex value_type;
+					typedef std::ptrdiff_t difference_type;
+					typedef const Vertex* pointer;
+					typedef Vertex reference;
+
+					const_iterator(	const SearchGrid* aGrid,
+									std::int32_t aCell);
+					Vertex operator*() const
+					{
+						return grid->cellVertex( cell);
+					}
+					const_iterator& operator++();
+					bool operator==( const const_iterator& rhs) const
+					{
+						return cell == rhs.cell;
+					}
+					bool operator!=( const const_iterator& rhs) const
+					{
+						return cell != rhs.cell;
+					}
+
+				private:
+					void skip();
+
+					const SearchGrid* grid;
+					std::int32_t cell;
+			};
+			/**
+			 *
+			 */
+			explicit ClosedSetView( const SearchGrid& aGrid) :
+				grid( &aGrid)
+			{
+			}
+			/**
+			 *
+			 */
+			bool contains( const Vertex& aVertex) const;
+			/**
+			 *
+			 */
+			std::size_t size() const
+			{
+				return grid->getClosedCount();
+			}
+			/**
+			 *
+			 */
+			bool empty() const
+			{
+				return size() == 0;
+			}
+			/**
+			 *
+			 */
+			const_iterator begin() const
+			{
+				return const_iterator( grid, 0);
+			}
+			/**
+			 *
+			 */
+			const_iterator end() const
+			{
+				return const_iterator( grid, grid->getCellCount());
+			}
+
+		private:
+			const SearchGrid* grid;
+	}; // class ClosedSetView
+
+	/**
+	 * A read-only view on the predecessors of a SearchGrid. It is only valid until the next search.
+	 */
+	class PredecessorMapView
+	{
+		public:
+			/**
+			 *
+			 */
+			class const_iterator
+			{
+				public:
+					typedef std::forward_iterator_tag iterator_category;
+					typedef std::pair< Vertex, Vertex > value_type;
+					typedef std::ptrdiff_t difference_type;
+					typedef const value_type* pointer;
+					typedef value_type reference;
+
+					const_iterator(	const SearchGrid* aGrid,
+									std::int32_t aCell);
+					value_type operator*() const
+					{
+						return std::make_pair( grid->cellVertex( cell), grid->cellVertex( grid->getPredecessor( cell)));
+					}
+					const_iterator& operator++();
+					bool operator==( const const_iterator& rhs) const
+					{
+						return cell == rhs.cell;
+					}
+					bool operator!=( const const_iterator& rhs) const
+					{
+						return cell != rhs.cell;
+					}
+
+				private:
+					void skip();
+
+					const SearchGrid* grid;
+					std::int32_t cell;
+			};
+			/**
+			 *
+			 */
+			explicit PredecessorMapView( const SearchGrid& aGrid) :
+				grid( &aGrid)
+			{
+			}
+			/**
+			 *
+			 * @return true if aVertex has a predecessor
+			 */
+			bool contains( const Vertex& aVertex) const;
+			/**
+			 *
+			 * @return the predecessor of aVertex, throws std::out_of_range if there is none
+			 */
+			Vertex at( const Vertex& aVertex) const;
+			/**
+			 *
+			 */
+			std::size_t size() const
+			{
+				return grid->getPredecessorCount();
+			}
+			/**
+			 *
+			 */
+			bool empty() const
+			{
+				return size() == 0;
+			}
+			/**
+			 *
+			 */
+			const_iterator begin() const
+			{
+				return const_iterator( grid, 0);
+			}
+			/**
+			 *
+			 */
+			const_iterator end() const
+			{
+				return const_iterator( grid, grid->getCellCount());
+			}
+
+		private:
+			const SearchGrid* grid;
+	}; // class PredecessorMapView
+} // namespace PathAlgorithm
+#endif // SEARCHGRID_HPP_
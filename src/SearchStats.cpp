@@ -0,0 +1,29 @@
+#include "SearchStats.hpp"
+
+#include <sstream>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	std::string SearchStats::asString() const
+	{
+		std::ostringstream os;
+		os << "expanded: " << expandedCount << ", open set peak: " << openSetPeak << ", reopened: " << reopenedCount
+		   << ", wall checks: " << wallCheckCount << ", allocations: " << allocationCount
+		   << ", time: " << std::chrono::duration< double, std::milli >( duration).count() << " ms";
+		return os.str();
+	}
+	/**
+	 *
+	 */
+	std::string SearchStats::asJson() const
+	{
+		std::ostringstream os;
+		os << "{\"expanded\":" << expandedCount << ",\"openSetPeak\":" << openSetPeak << ",\"reopened\":" << reopenedCount
+		   << ",\"wallChecks\":" << wallCheckCount << ",\"allocations\":" << allocationCount
+		   << ",\"durationNs\":" << duration.count() << "}";
+		return os.str();
+	}
+} // namespace PathAlgorithm
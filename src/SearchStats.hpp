@@ -0,0 +1,59 @@
+#ifndef SEARCHSTATS_HPP_
+#define SEARCHSTATS_HPP_
+
+#include "Config.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace PathAlgorithm
+{
+	/**
+	 * What a search of a path planner cost. Every search starts with a cleared SearchStats, a search that is
+	 * resumed in steps adds to it.
+	 */
+	struct SearchStats
+	{
+		/**
+		 * The Vertices (or cells) taken from the open set and expanded
+		 */
+		std::size_t expandedCount = 0;
+		/**
+		 * The largest number of Vertices in the open set(s) at the same time
+		 */
+		std::size_t openSetPeak = 0;
+		/**
+		 * The closed Vertices that were opened again because a shorter route to them was found
+		 */
+		std::size_t reopenedCount = 0;
+		/**
+		 * The lookups in the OccupancyGrid whether cells are blocked by a wall
+		 */
+		std::size_t wallCheckCount = 0;
+		/**
+		 * The times the storage of the search had to grow: the open set and its index, the successors and the path
+		 */
+		std::size_t allocationCount = 0;
+		/**
+		 * The wall-clock time of the search
+		 */
+		std::chrono::nanoseconds duration{ 0 };
+		/**
+		 *
+		 */
+		void clear()
+		{
+			*this = SearchStats();
+		}
+		/**
+		 * Returns a 1-line description for the log
+		 */
+		std::string asString() const;
+		/**
+		 * Returns the statistics as a single line JSON object, for regression tracking
+		 */
+		std::string asJson() const;
+	}; // struct SearchStats
+} // namespace PathAlgorithm
+#endif // SEARCHSTATS_HPP_
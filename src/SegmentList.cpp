@@ -0,0 +1,56 @@
+#include "SegmentList.hpp"
+
+namespace Utils
+{
+	/**
+	 *
+	 */
+	SegmentList::SegmentList()
+	{
+	}
+	/**
+	 *
+	 */
+	void SegmentList::add(	const wxPoint& aStartPoint,
+							const wxPoint& anEndPoint)
+	{
+		startXs.push_back( aStartPoint.x);
+		startYs.push_back( aStartPoint.y);
+		endXs.push_back( anEndPoint.x);
+		endYs.push_back( anEndPoint.y);
+	}
+	/**
+	 *
+	 */
+	void SegmentList::clear()
+	{
+		startXs.clear();
+		startYs.clear();
+		endXs.clear();
+		endYs.clear();
+	}
+	/**
+	 *
+	 */
+	void SegmentList::reserve( std::size_t aCapacity)
+	{
+		startXs.reserve( aCapacity);
+		startYs.reserve( aCapacity);
+		endXs.reserve( aCapacity);
+		endYs.reserve( aCapacity);
+	}
+	/**
+	 *
+	 */
+	wxPoint SegmentList::getStartPoint( std::size_t anIndex) const
+	{
+		return wxPoint( static_cast< int >( startXs[anIndex]), static_cast< int >( startYs[anIndex]));
+	}
+	/**
+	 *
+	 */
+	wxPoint SegmentList::getEndPoint( std::size_t anIndex) const
+	{
+		return wxPoint( static_cast< int >( endXs[anIndex]), static_cast< int >( endYs[anIndex]));
+	}
+} // namespace Utils
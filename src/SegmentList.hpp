@@ -0,0 +1,87 @@
+#ifndef SEGMENTLIST_HPP_
+#define SEGMENTLIST_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Utils
+{
+	/**
+	 * A list of line segments stored as a structure of arrays: the x and y of the start and end points each in
+	 * their own contiguous array, so that a batched test can load the same coordinate of several segments at once.
+	 * The storage is kept by clear() so a list that is refilled every tick does not allocate.
+	 */
+	class SegmentList
+	{
+		public:
+			/**
+			 *
+			 */
+			SegmentList();
+			/**
+			 *
+			 */
+			void add(	const wxPoint& aStartPoint,
+						const wxPoint& anEndPoint);
+			/**
+			 *
+			 */
+			void clear();
+			/**
+			 *
+			 */
+			void reserve( std::size_t aCapacity);
+			/**
+			 *
+			 */
+			std::size_t size() const
+			{
+				return startXs.size();
+			}
+			/**
+			 *
+			 */
+			bool empty() const
+			{
+				return startXs.empty();
+			}
+			/**
+			 * The coordinates of all segments, size() of each
+			 */
+			const double* getStartXs() const
+			{
+				return startXs.data();
+			}
+			const double* getStartYs() const
+			{
+				return startYs.data();
+			}
+			const double* getEndXs() const
+			{
+				return endXs.data();
+			}
+			const double* getEndYs() const
+			{
+				return endYs.data();
+			}
+			/**
+			 *
+			 */
+			wxPoint getStartPoint( std::size_t anIndex) const;
+			/**
+			 *
+			 */
+			wxPoint getEndPoint( std::size_t anIndex) const;
+
+		private:
+			std::vector< double > startXs;
+			std::vector< double > startYs;
+			std::vector< double > endXs;
+			std::vector< double > endYs;
+	}; // class SegmentList
+} // namespace Utils
+#endif // SEGMENTLIST_HPP_
@@ -5,6 +5,12 @@
 #include <algorithm>
 #include <sstream>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace Utils
 {
 	/**
@@ -167,6 +173,190 @@ namespace Utils
 		// Return the point of intersection
 		return wxPoint( static_cast<int>(x), static_cast<int>(y));
 	}
+	/**
+	 *
+	 */
+	/* static */ bool Shape2DUtils::intersect(	const wxPoint* aPolygon,
+												int aNumberOfPoints,
+												const SegmentList& aSegments,
+												std::vector< std::uint32_t >& aHitMasks,
+												bool aClosedShape /*= true*/)
+	{
+		std::size_t numberOfSegments = aSegments.size();
+		aHitMasks.assign( numberOfSegments, 0);
+
+		int numberOfLines = std::min( aClosedShape ? aNumberOfPoints : aNumberOfPoints - 1, 32);
+		if (aNumberOfPoints < 2 || numberOfSegments == 0)
+		{
+			return false;
+		}
+
+		const double* x3s = aSegments.getStartXs();
+		const double* y3s = aSegments.getStartYs();
+		const double* x4s = aSegments.getEndXs();
+		const double* y4s = aSegments.getEndYs();
+
+		for (int line = 0; line < numberOfLines; ++line)
+		{
+			const wxPoint& startPoint = aPolygon[line];
+			const wxPoint& endPoint = aPolygon[(line + 1) % aNumberOfPoints];
+			std::uint32_t lineBit = std::uint32_t( 1) << line;
+
+			// The terms of the line itself are the same for every segment, see getIntersection for the formulas
+			double x1 = startPoint.x;
+			double y1 = startPoint.y;
+			double x2 = endPoint.x;
+			double y2 = endPoint.y;
+			double x1mx2 = x1 - x2;
+			double y1my2 = y1 - y2;
+			double pre = x1 * y2 - y1 * x2;
+
+			std::size_t i = 0;
+#if defined(__AVX__)
+			const __m256d epsilon = _mm256_set1_pd( std::numeric_limits< float >::epsilon());
+			const __m256d signMask = _mm256_set1_pd( -0.0);
+			const __m256d lineX = _mm256_set1_pd( x1mx2);
+			const __m256d lineY = _mm256_set1_pd( y1my2);
+			const __m256d linePre = _mm256_set1_pd( pre);
+			const __m256d lineMinX = _mm256_set1_pd( std::min( x1, x2));
+			const __m256d lineMaxX = _mm256_set1_pd( std::max( x1, x2));
+			const __m256d lineMinY = _mm256_set1_pd( std::min( y1, y2));
+			const __m256d lineMaxY = _mm256_set1_pd( std::max( y1, y2));
+			for (; i + 4 <= numberOfSegments; i += 4)
+			{
+				__m256d x3 = _mm256_loadu_pd( x3s + i);
+				__m256d y3 = _mm256_loadu_pd( y3s + i);
+				__m256d x4 = _mm256_loadu_pd( x4s + i);
+				__m256d y4 = _mm256_loadu_pd( y4s + i);
+				__m256d x3mx4 = _mm256_sub_pd( x3, x4);
+				__m256d y3my4 = _mm256_sub_pd( y3, y4);
+
+				__m256d d = _mm256_sub_pd( _mm256_mul_pd( lineX, y3my4), _mm256_mul_pd( lineY, x3mx4));
+				__m256d post = _mm256_sub_pd( _mm256_mul_pd( x3, y4), _mm256_mul_pd( y3, x4));
+				__m256d x = _mm256_div_pd( _mm256_sub_pd( _mm256_mul_pd( linePre, x3mx4), _mm256_mul_pd( lineX, post)), d);
+				__m256d y = _mm256_div_pd( _mm256_sub_pd( _mm256_mul_pd( linePre, y3my4), _mm256_mul_pd( lineY, post)), d);
+
+				__m256d hits = _mm256_cmp_pd( _mm256_andnot_pd( signMask, d), epsilon, _CMP_GT_OQ);
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( x, lineMinX, _CMP_GE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( x, lineMaxX, _CMP_LE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( x, _mm256_min_pd( x3, x4), _CMP_GE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( x, _mm256_max_pd( x3, x4), _CMP_LE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( y, lineMinY, _CMP_GE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( y, lineMaxY, _CMP_LE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( y, _mm256_min_pd( y3, y4), _CMP_GE_OQ));
+				hits = _mm256_and_pd( hits, _mm256_cmp_pd( y, _mm256_max_pd( y3, y4), _CMP_LE_OQ));
+
+				int mask = _mm256_movemask_pd( hits);
+				for (int lane = 0; mask != 0; ++lane, mask >>= 1)
+				{
+					if (mask & 1)
+					{
+						aHitMasks[i + lane] |= lineBit;
+					}
+				}
+			}
+#elif defined(__SSE2__)
+			const __m128d epsilon = _mm_set1_pd( std::numeric_limits< float >::epsilon());
+			const __m128d signMask = _mm_set1_pd( -0.0);
+			const __m128d lineX = _mm_set1_pd( x1mx2);
+			const __m128d lineY = _mm_set1_pd( y1my2);
+			const __m128d linePre = _mm_set1_pd( pre);
+			const __m128d lineMinX = _mm_set1_pd( std::min( x1, x2));
+			const __m128d lineMaxX = _mm_set1_pd( std::max( x1, x2));
+			const __m128d lineMinY = _mm_set1_pd( std::min( y1, y2));
+			const __m128d lineMaxY = _mm_set1_pd( std::max( y1, y2));
+			for (; i + 2 <= numberOfSegments; i += 2)
+			{
+				__m128d x3 = _mm_loadu_pd( x3s + i);
+				__m128d y3 = _mm_loadu_pd( y3s + i);
+				__m128d x4 = _mm_loadu_pd( x4s + i);
+				__m128d y4 = _mm_loadu_pd( y4s + i);
+				__m128d x3mx4 = _mm_sub_pd( x3, x4);
+				__m128d y3my4 = _mm_sub_pd( y3, y4);
+
+				__m128d d = _mm_sub_pd( _mm_mul_pd( lineX, y3my4), _mm_mul_pd( lineY, x3mx4));
+				__m128d post = _mm_sub_pd( _mm_mul_pd( x3, y4), _mm_mul_pd( y3, x4));
+				__m128d x = _mm_div_pd( _mm_sub_pd( _mm_mul_pd( linePre, x3mx4), _mm_mul_pd( lineX, post)), d);
+				__m128d y = _mm_div_pd( _mm_sub_pd( _mm_mul_pd( linePre, y3my4), _mm_mul_pd( lineY, post)), d);
+
+				__m128d hits = _mm_cmpgt_pd( _mm_andnot_pd( signMask, d), epsilon);
+				hits = _mm_and_pd( hits, _mm_cmpge_pd( x, lineMinX));
+				hits = _mm_and_pd( hits, _mm_cmple_pd( x, lineMaxX));
+				hits = _mm_and_pd( hits, _mm_cmpge_pd( x, _mm_min_pd( x3, x4)));
+				hits = _mm_and_pd( hits, _mm_cmple_pd( x, _mm_max_pd( x3, x4)));
+				hits = _mm_and_pd( hits, _mm_cmpge_pd( y, lineMinY));
+				hits = _mm_and_pd( hits, _mm_cmple_pd( y, lineMaxY));
+				hits = _mm_and_pd( hits, _mm_cmpge_pd( y, _mm_min_pd( y3, y4)));
+				hits = _mm_and_pd( hits, _mm_cmple_pd( y, _mm_max_pd( y3, y4)));
+
+				int mask = _mm_movemask_pd( hits);
+				if (mask & 1)
+				{
+					aHitMasks[i] |= lineBit;
+				}
+				if (mask & 2)
+				{
+					aHitMasks[i + 1] |= lineBit;
+				}
+			}
+#endif
+			// The segments that do not fill a whole vector, or all of them without SIMD
+			for (; i < numberOfSegments; ++i)
+			{
+				if (intersect( startPoint, endPoint, aSegments.getStartPoint( i), aSegments.getEndPoint( i)))
+				{
+					aHitMasks[i] |= lineBit;
+				}
+			}
+		}
+
+		return std::any_of( aHitMasks.begin(), aHitMasks.end(), []( std::uint32_t aMask){ return aMask != 0;});
+	}
+	/**
+	 *
+	 */
+	/* static */ int Shape2DUtils::getConvexHull(	const wxPoint* aPoints,
+													int aNumberOfPoints,
+													wxPoint* aHull)
+	{
+		std::vector< wxPoint > points( aPoints, aPoints + aNumberOfPoints);
+		std::sort( points.begin(), points.end(), []( const wxPoint& lhs, const wxPoint& rhs){ return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);});
+		points.erase( std::unique( points.begin(), points.end()), points.end());
+		if (points.size() < 3)
+		{
+			std::copy( points.begin(), points.end(), aHull);
+			return static_cast< int >( points.size());
+		}
+
+		// The cross product of (b - a) and (c - a), positive if a, b, c turn counterclockwise
+		auto cross = []( const wxPoint& a, const wxPoint& b, const wxPoint& c)
+		{
+			return static_cast< long long >( b.x - a.x) * (c.y - a.y) - static_cast< long long >( b.y - a.y) * (c.x - a.x);
+		};
+
+		// The lower chain from left to right and then the upper chain back, the first point closes the hull
+		std::vector< wxPoint > hull( 2 * points.size());
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < points.size(); ++i)
+		{
+			while (size >= 2 && cross( hull[size - 2], hull[size - 1], points[i]) <= 0)
+			{
+				--size;
+			}
+			hull[size++] = points[i];
+		}
+		for (std::size_t i = points.size() - 1, lowerSize = size + 1; i > 0; --i)
+		{
+			while (size >= lowerSize && cross( hull[size - 2], hull[size - 1], points[i - 1]) <= 0)
+			{
+				--size;
+			}
+			hull[size++] = points[i - 1];
+		}
+
+		std::copy( hull.begin(), hull.begin() + static_cast< std::ptrdiff_t >( size - 1), aHull);
+		return static_cast< int >( size - 1);
+	}
 	/**
 	 *
 	 */
@@ -6,9 +6,12 @@
 #include "BoundedVector.hpp"
 #include "MathUtils.hpp"
 #include "Point.hpp"
+#include "SegmentList.hpp"
 #include "Size.hpp"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Utils
 {
@@ -56,6 +59,23 @@ namespace Utils
 											const wxPoint& anEndLine1,
 											const wxPoint& aStartLine2,
 											const wxPoint& anEndLine2);
+			/**
+			 * Tests the lines of a path against all segments of aSegments at once, with the same outcome as
+			 * intersect() for every pair. The segments are processed two or four at a time with SSE2 or AVX
+			 * if the compiler targets those, one at a time otherwise.
+			 *
+			 * @param aPolygon The array of points that form a path
+			 * @param aNumberOfPoints The number of points in the array, at most 32 lines may result
+			 * @param aSegments The segments to test against, e.g. the walls around a robot
+			 * @param aHitMasks Set to one mask per segment: bit i is set if line i of the path intersects it
+			 * @param aClosedShape True if the path is closed, false otherwise
+			 * @return True if any line intersects any segment
+			 */
+			static bool intersect(	const wxPoint* aPolygon,
+									int aNumberOfPoints,
+									const SegmentList& aSegments,
+									std::vector< std::uint32_t >& aHitMasks,
+									bool aClosedShape = true);
 			/**
 			 *
 			 * @param aPoint1
@@ -134,6 +154,18 @@ namespace Utils
 													const wxSize& aSize,
 													const wxPoint& aBorderPoint,
 													int aRadius = 6);
+			/**
+			 * The smallest convex polygon around the points, found with Andrew's monotone chain. Points on
+			 * the border that are not corners are left out.
+			 *
+			 * @param aPoints The array of points
+			 * @param aNumberOfPoints The number of points in the array
+			 * @param aHull Receives the corners of the hull in order, must have room for aNumberOfPoints points
+			 * @return The number of corners of the hull
+			 */
+			static int getConvexHull(	const wxPoint* aPoints,
+										int aNumberOfPoints,
+										wxPoint* aHull);
 			/**
 			 *
 			 * @param aBorderPoint
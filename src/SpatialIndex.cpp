@@ -0,0 +1,402 @@
+#include "SpatialIndex.hpp"
+
+#include "Robot.hpp"
+#include "Wall.hpp"
+#include "WayPoint.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Model
+{
+	namespace
+	{
+		/**
+		 * Rounds towards minus infinity, also for negative coordinates
+		 */
+		int FloorDivide(	int aValue,
+							int aDivisor)
+		{
+			return aValue >= 0 ? aValue / aDivisor : -((-aValue + aDivisor - 1) / aDivisor);
+		}
+		/**
+		 *
+		 */
+		long SquaredDistance(	const wxPoint& aPoint,
+								const wxPoint& anOtherPoint)
+		{
+			long dx = aPoint.x - anOtherPoint.x;
+			long dy = aPoint.y - anOtherPoint.y;
+			return dx * dx + dy * dy;
+		}
+		/**
+		 * The position of a point object and the bounding box of a wall
+		 */
+		wxPoint Low( const Robot& aRobot)
+		{
+			return aRobot.getPosition();
+		}
+		wxPoint High( const Robot& aRobot)
+		{
+			return aRobot.getPosition();
+		}
+		wxPoint Low( const WayPoint& aWayPoint)
+		{
+			return aWayPoint.getPosition();
+		}
+		wxPoint High( const WayPoint& aWayPoint)
+		{
+			return aWayPoint.getPosition();
+		}
+		wxPoint Low( const Wall& aWall)
+		{
+			return wxPoint( std::min( aWall.getPoint1().x, aWall.getPoint2().x), std::min( aWall.getPoint1().y, aWall.getPoint2().y));
+		}
+		wxPoint High( const Wall& aWall)
+		{
+			return wxPoint( std::max( aWall.getPoint1().x, aWall.getPoint2().x), std::max( aWall.getPoint1().y, aWall.getPoint2().y));
+		}
+	} // namespace
+	/**
+	 *
+	 */
+	SpatialIndex::SpatialIndex( int aCellSize /*= 64*/) :
+		cellSize( std::max( aCellSize, 1))
+	{
+	}
+	/**
+	 *
+	 */
+	std::uint64_t SpatialIndex::cellKey(	int aColumn,
+											int aRow) const
+	{
+		return (static_cast< std::uint64_t >( static_cast< std::uint32_t >( aColumn)) << 32) | static_cast< std::uint32_t >( aRow);
+	}
+	/**
+	 *
+	 */
+	std::vector< std::uint64_t > SpatialIndex::coveredCells(	const wxPoint& aPoint1,
+																const wxPoint& aPoint2) const
+	{
+		std::vector< std::uint64_t > cells;
+		for (int column = FloorDivide( aPoint1.x, cellSize); column <= FloorDivide( aPoint2.x, cellSize); ++column)
+		{
+			for (int row = FloorDivide( aPoint1.y, cellSize); row <= FloorDivide( aPoint2.y, cellSize); ++row)
+			{
+				cells.push_back( cellKey( column, row));
+			}
+		}
+		return cells;
+	}
+	/**
+	 *
+	 */
+	template< typename T >
+	void SpatialIndex::place(	Layer< T >& aLayer,
+								const std::shared_ptr< T >& anObject,
+								std::vector< std::uint64_t > aCells)
+	{
+		for (std::uint64_t cell : aCells)
+		{
+			aLayer.cells[cell].push_back( anObject);
+		}
+		aLayer.entries[anObject.get()] = typename Layer< T >::Entry{ anObject, std::move( aCells) };
+	}
+	/**
+	 *
+	 */
+	template< typename T >
+	void SpatialIndex::unplace(	Layer< T >& aLayer,
+								const T* anObject)
+	{
+		auto entry = aLayer.entries.find( anObject);
+		if (entry == aLayer.entries.end())
+		{
+			return;
+		}
+		for (std::uint64_t cell : entry->second.cells)
+		{
+			auto objects = aLayer.cells.find( cell);
+			if (objects != aLayer.cells.end())
+			{
+				objects->second.erase( std::remove( objects->second.begin(), objects->second.end(), entry->second.object), objects->second.end());
+				if (objects->second.empty())
+				{
+					aLayer.cells.erase( objects);
+				}
+			}
+		}
+		aLayer.entries.erase( entry);
+	}
+	/**
+	 *
+	 */
+	template< typename T >
+	std::vector< std::shared_ptr< T > > SpatialIndex::findNear(	const Layer< T >& aLayer,
+																	const wxPoint& aPoint,
+																	int aRadius) const
+	{
+		std::vector< std::shared_ptr< T > > found;
+		int firstColumn = FloorDivide( aPoint.x - aRadius, cellSize);
+		int lastColumn = FloorDivide( aPoint.x + aRadius, cellSize);
+		int firstRow = FloorDivide( aPoint.y - aRadius, cellSize);
+		int lastRow = FloorDivide( aPoint.y + aRadius, cellSize);
+		for (int column = firstColumn; column <= lastColumn; ++column)
+		{
+			for (int row = firstRow; row <= lastRow; ++row)
+			{
+				auto objects = aLayer.cells.find( cellKey( column, row));
+				if (objects == aLayer.cells.end())
+				{
+					continue;
+				}
+				for (const std::shared_ptr< T >& object : objects->second)
+				{
+					wxPoint low = Low( *object);
+					wxPoint high = High( *object);
+					if (high.x < aPoint.x - aRadius || low.x > aPoint.x + aRadius || high.y < aPoint.y - aRadius || low.y > aPoint.y + aRadius)
+					{
+						continue;
+					}
+					// A wall in several cells is only taken in the first cell that both it and the query cover
+					if (low != high &&
+						(std::max( FloorDivide( low.x, cellSize), firstColumn) != column || std::max( FloorDivide( low.y, cellSize), firstRow) != row))
+					{
+						continue;
+					}
+					found.push_back( object);
+				}
+			}
+		}
+		return found;
+	}
+	/**
+	 *
+	 */
+	template< typename T >
+	std::shared_ptr< T > SpatialIndex::findNearest(	const Layer< T >& aLayer,
+														const wxPoint& aPoint,
+														const T* anExcluded) const
+	{
+		std::shared_ptr< T > nearest;
+		long nearestDistance = std::numeric_limits< long >::max();
+		std::size_t candidates = aLayer.entries.size() - (anExcluded && aLayer.entries.count( anExcluded) ? 1 : 0);
+		if (candidates == 0)
+		{
+			return nearest;
+		}
+
+		// Search rings of cells around the cell of aPoint until no cell of the next ring can hold anything closer
+		int centreColumn = FloorDivide( aPoint.x, cellSize);
+		int centreRow = FloorDivide( aPoint.y, cellSize);
+		std::size_t seen = 0;
+		for (int ring = 0;; ++ring)
+		{
+			if (nearest)
+			{
+				long ringDistance = static_cast< long >( ring - 1) * cellSize;
+				if (ringDistance > 0 && ringDistance * ringDistance > nearestDistance)
+				{
+					break;
+				}
+			}
+			if (seen == candidates && nearest)
+			{
+				break;
+			}
+			for (int column = centreColumn - ring; column <= centreColumn + ring; ++column)
+			{
+				// Only the cells on the border of the ring, the inner ones were searched before
+				bool border = column == centreColumn - ring || column == centreColumn + ring;
+				for (int row = centreRow - ring; row <= centreRow + ring; row += border || ring == 0 ? 1 : 2 * ring)
+				{
+					auto objects = aLayer.cells.find( cellKey( column, row));
+					if (objects == aLayer.cells.end())
+					{
+						continue;
+					}
+					for (const std::shared_ptr< T >& object : objects->second)
+					{
+						if (object.get() == anExcluded)
+						{
+							continue;
+						}
+						++seen;
+						long distance = SquaredDistance( aPoint, Low( *object));
+						if (distance < nearestDistance)
+						{
+							nearestDistance = distance;
+							nearest = object;
+						}
+					}
+				}
+			}
+		}
+		return nearest;
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::insert( const RobotPtr& aRobot)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		unplace( robots, aRobot.get());
+		place( robots, aRobot, coveredCells( Low( *aRobot), High( *aRobot)));
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::insert( const WayPointPtr& aWayPoint)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		unplace( wayPoints, aWayPoint.get());
+		place( wayPoints, aWayPoint, coveredCells( Low( *aWayPoint), High( *aWayPoint)));
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::insert( const WallPtr& aWall)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		unplace( walls, aWall.get());
+		place( walls, aWall, coveredCells( Low( *aWall), High( *aWall)));
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::remove( const Robot* aRobot)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		unplace( robots, aRobot);
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::remove( const WayPoint* aWayPoint)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		unplace( wayPoints, aWayPoint);
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::remove( const Wall* aWall)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		unplace( walls, aWall);
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::update( const Robot* aRobot)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		auto entry = robots.entries.find( aRobot);
+		if (entry == robots.entries.end())
+		{
+			return;
+		}
+		// Most steps stay in the same cell
+		std::vector< std::uint64_t > cells = coveredCells( Low( *aRobot), High( *aRobot));
+		if (cells != entry->second.cells)
+		{
+			RobotPtr robot = entry->second.object;
+			unplace( robots, aRobot);
+			place( robots, robot, std::move( cells));
+		}
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::update( const WayPoint* aWayPoint)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		auto entry = wayPoints.entries.find( aWayPoint);
+		if (entry != wayPoints.entries.end())
+		{
+			WayPointPtr wayPoint = entry->second.object;
+			unplace( wayPoints, aWayPoint);
+			place( wayPoints, wayPoint, coveredCells( Low( *aWayPoint), High( *aWayPoint)));
+		}
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::update( const Wall* aWall)
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		auto entry = walls.entries.find( aWall);
+		if (entry != walls.entries.end())
+		{
+			WallPtr wall = entry->second.object;
+			unplace( walls, aWall);
+			place( walls, wall, coveredCells( Low( *aWall), High( *aWall)));
+		}
+	}
+	/**
+	 *
+	 */
+	void SpatialIndex::clear()
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		robots = Layer< Robot >();
+		wayPoints = Layer< WayPoint >();
+		walls = Layer< Wall >();
+	}
+	/**
+	 *
+	 */
+	std::vector< RobotPtr > SpatialIndex::findRobots(	const wxPoint& aPoint,
+														int aRadius) const
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		std::vector< RobotPtr > found = findNear( robots, aPoint, aRadius);
+		found.erase( std::remove_if( found.begin(), found.end(), [&aPoint, aRadius]( const RobotPtr& aRobot)
+									 {
+										 return SquaredDistance( aPoint, aRobot->getPosition()) > static_cast< long >( aRadius) * aRadius;
+									 }),
+					 found.end());
+		return found;
+	}
+	/**
+	 *
+	 */
+	RobotPtr SpatialIndex::findNearestRobot(	const wxPoint& aPoint,
+												const Robot* anExcluded /*= nullptr*/) const
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		return findNearest( robots, aPoint, anExcluded);
+	}
+	/**
+	 *
+	 */
+	std::vector< WayPointPtr > SpatialIndex::findWayPoints(	const wxPoint& aPoint,
+																int aRadius) const
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		std::vector< WayPointPtr > found = findNear( wayPoints, aPoint, aRadius);
+		found.erase( std::remove_if( found.begin(), found.end(), [&aPoint, aRadius]( const WayPointPtr& aWayPoint)
+									 {
+										 return SquaredDistance( aPoint, aWayPoint->getPosition()) > static_cast< long >( aRadius) * aRadius;
+									 }),
+					 found.end());
+		return found;
+	}
+	/**
+	 *
+	 */
+	WayPointPtr SpatialIndex::findNearestWayPoint( const wxPoint& aPoint) const
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		return findNearest( wayPoints, aPoint, static_cast< const WayPoint* >( nullptr));
+	}
+	/**
+	 *
+	 */
+	std::vector< WallPtr > SpatialIndex::findWalls(	const wxPoint& aPoint,
+														int aRadius) const
+	{
+		std::lock_guard< std::mutex > lock( indexMutex);
+		return findNear( walls, aPoint, aRadius);
+	}
+} // namespace Model
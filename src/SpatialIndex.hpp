@@ -0,0 +1,145 @@
+#ifndef SPATIALINDEX_HPP_
+#define SPATIALINDEX_HPP_
+
+#include "Config.hpp"
+
+#include "Point.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Model
+{
+	class Robot;
+	typedef std::shared_ptr< Robot > RobotPtr;
+
+	class WayPoint;
+	typedef std::shared_ptr< WayPoint > WayPointPtr;
+
+	class Wall;
+	typedef std::shared_ptr< Wall > WallPtr;
+
+	/**
+	 * The SpatialIndex is a uniform grid of square cells over the RobotWorld. Every robot and waypoint (goals
+	 * included) is in the cell of its position, every wall in all cells that its bounding box covers. A query
+	 * only visits the cells around the query point, so its cost depends on the number of objects nearby and
+	 * not on the number of objects in the world.
+	 *
+	 * The index does not observe the objects: whoever moves an object calls update() for it.
+	 * All functions lock the index, the results are copies.
+	 */
+	class SpatialIndex
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit SpatialIndex( int aCellSize = 64);
+			/**
+			 *
+			 */
+			void insert( const RobotPtr& aRobot);
+			void insert( const WayPointPtr& aWayPoint);
+			void insert( const WallPtr& aWall);
+			/**
+			 *
+			 */
+			void remove( const Robot* aRobot);
+			void remove( const WayPoint* aWayPoint);
+			void remove( const Wall* aWall);
+			/**
+			 * Moves the object to the cell(s) of its current position, nothing happens if it is not in the index
+			 */
+			void update( const Robot* aRobot);
+			void update( const WayPoint* aWayPoint);
+			void update( const Wall* aWall);
+			/**
+			 *
+			 */
+			void clear();
+			/**
+			 *
+			 * @return the robots whose position is at most aRadius from aPoint
+			 */
+			std::vector< RobotPtr > findRobots(	const wxPoint& aPoint,
+												int aRadius) const;
+			/**
+			 *
+			 * @return the robot closest to aPoint other than anExcluded, nullptr if there is none
+			 */
+			RobotPtr findNearestRobot(	const wxPoint& aPoint,
+										const Robot* anExcluded = nullptr) const;
+			/**
+			 *
+			 * @return the waypoints and goals whose position is at most aRadius from aPoint
+			 */
+			std::vector< WayPointPtr > findWayPoints(	const wxPoint& aPoint,
+														int aRadius) const;
+			/**
+			 *
+			 * @return the waypoint or goal closest to aPoint, nullptr if there is none
+			 */
+			WayPointPtr findNearestWayPoint( const wxPoint& aPoint) const;
+			/**
+			 *
+			 * @return the walls whose bounding box overlaps the square of aRadius around aPoint, the candidates for
+			 * a precise test
+			 */
+			std::vector< WallPtr > findWalls(	const wxPoint& aPoint,
+												int aRadius) const;
+
+		private:
+			/**
+			 * The objects of one kind with the cells they are in
+			 */
+			template< typename T >
+			struct Layer
+			{
+				struct Entry
+				{
+					std::shared_ptr< T > object;
+					std::vector< std::uint64_t > cells;
+				};
+				std::unordered_map< std::uint64_t, std::vector< std::shared_ptr< T > > > cells;
+				std::unordered_map< const T*, Entry > entries;
+			};
+			/**
+			 *
+			 */
+			std::uint64_t cellKey(	int aColumn,
+									int aRow) const;
+			/**
+			 * The cells that the bounding box of aPoint1 and aPoint2 covers
+			 */
+			std::vector< std::uint64_t > coveredCells(	const wxPoint& aPoint1,
+														const wxPoint& aPoint2) const;
+			/**
+			 *
+			 */
+			template< typename T >
+			void place(	Layer< T >& aLayer,
+						const std::shared_ptr< T >& anObject,
+						std::vector< std::uint64_t > aCells);
+			template< typename T >
+			void unplace(	Layer< T >& aLayer,
+							const T* anObject);
+			template< typename T >
+			std::vector< std::shared_ptr< T > > findNear(	const Layer< T >& aLayer,
+															const wxPoint& aPoint,
+															int aRadius) const;
+			template< typename T >
+			std::shared_ptr< T > findNearest(	const Layer< T >& aLayer,
+												const wxPoint& aPoint,
+												const T* anExcluded) const;
+
+			int cellSize;
+			Layer< Robot > robots;
+			Layer< WayPoint > wayPoints;
+			Layer< Wall > walls;
+			mutable std::mutex indexMutex;
+	}; // class SpatialIndex
+} // namespace Model
+#endif // SPATIALINDEX_HPP_
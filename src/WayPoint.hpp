@@ -4,6 +4,7 @@
 #include "Config.hpp"
 
 #include "ModelObject.hpp"
+#include "OrientedBox.hpp"
 #include "Point.hpp"
 #include "Region.hpp"
 
@@ -58,13 +59,13 @@ namespace Model
 			void setPosition(	const wxPoint& aPosition,
 								bool aNotifyObservers = true);
 			/**
-			 *
+			 * The square of its size around the position
 			 */
-			wxRegion getRegion() const;
+			Utils::OrientedBox getBox() const;
 			/**
 			 *
 			 */
-			bool intersects( const wxRegion& aRegion) const;
+			bool intersects( const Utils::OrientedBox& aBox) const;
 			/**
 			 * @name Debug functions
 			 */